@@ -37,6 +37,9 @@ struct Preferences {
     int16_t volume;
     bool    fullscreen;
     Size    window_size;
+    bool    discard_pixels;
+    int     swap_interval;  // 0: no vsync; 1: vsync; -1: adaptive vsync, where supported.
+    int     frame_cap;      // maximum frames per second, or 0 for no limit.
 };
 
 class PrefsDriver {
@@ -54,6 +57,9 @@ class PrefsDriver {
     int  volume() const { return get().volume; }
     int  fullscreen() const { return get().fullscreen; }
     Size window_size() const { return get().window_size; }
+    bool discard_pixels() const { return get().discard_pixels; }
+    int  swap_interval() const { return get().swap_interval; }
+    int  frame_cap() const { return get().frame_cap; }
 
     void set_key(size_t index, Key key);
     void set_play_idle_music(bool on);
@@ -62,6 +68,9 @@ class PrefsDriver {
     void set_volume(int volume);
     void set_fullscreen(bool on);
     void set_window_size(Size size);
+    void set_discard_pixels(bool on);
+    void set_swap_interval(int interval);
+    void set_frame_cap(int fps);
 
     static PrefsDriver* driver();
 };
@@ -0,0 +1,115 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_DATA_ASSET_CACHE_HPP_
+#define ANTARES_DATA_ASSET_CACHE_HPP_
+
+#include <stdint.h>
+#include <list>
+#include <map>
+#include <sfz/sfz.hpp>
+
+namespace antares {
+
+// Holds assets that are loaded but no longer in use, such as the sprites of the last level, so
+// that they can be picked up again instead of loaded from scratch.
+//
+// Assets move in and out: `put()` stores one when it stops being used, and `take()` removes it
+// when it is needed again.  Each asset has a cost, such as its size in bytes.  When the total
+// cost exceeds the budget, the assets that were stored longest ago are evicted first.
+template <typename Key, typename Value>
+class AssetCache {
+  public:
+    struct Stats {
+        int64_t hits      = 0;  // Calls to `take()` that found an asset.
+        int64_t misses    = 0;  // Calls to `take()` that didn't.
+        int64_t evictions = 0;  // Assets dropped to stay within budget.
+    };
+
+    explicit AssetCache(size_t budget) : _budget(budget) {}
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    // Removes the asset stored under `key` and returns it, or returns nullopt if there is none.
+    sfz::optional<Value> take(const Key& key) {
+        auto it = _entries.find(key);
+        if (it == _entries.end()) {
+            ++_stats.misses;
+            return sfz::nullopt;
+        }
+        ++_stats.hits;
+        sfz::optional<Value> value{std::move(it->second.value)};
+        erase(it);
+        return value;
+    }
+
+    // Stores `value` under `key`, replacing any asset already stored there, then evicts assets
+    // until the total cost is within budget.  An asset costing more than the whole budget is
+    // dropped immediately.
+    void put(Key key, Value value, size_t cost) {
+        auto it = _entries.find(key);
+        if (it != _entries.end()) {
+            erase(it);
+        }
+        if (cost > _budget) {
+            ++_stats.evictions;
+            return;
+        }
+        it = _entries.emplace(std::move(key), Entry{std::move(value), cost, _order.end()}).first;
+        it->second.order = _order.insert(_order.begin(), &it->first);
+        _cost += cost;
+        while (_cost > _budget) {
+            erase(_entries.find(*_order.back()));
+            ++_stats.evictions;
+        }
+    }
+
+    void clear() {
+        _entries.clear();
+        _order.clear();
+        _cost = 0;
+    }
+
+    size_t       budget() const { return _budget; }
+    size_t       cost() const { return _cost; }
+    size_t       size() const { return _entries.size(); }
+    const Stats& stats() const { return _stats; }
+
+  private:
+    struct Entry {
+        Value                                    value;
+        size_t                                   cost;
+        typename std::list<const Key*>::iterator order;
+    };
+
+    void erase(typename std::map<Key, Entry>::iterator it) {
+        _cost -= it->second.cost;
+        _order.erase(it->second.order);
+        _entries.erase(it);
+    }
+
+    const size_t          _budget;
+    size_t                _cost = 0;
+    std::map<Key, Entry>  _entries;
+    std::list<const Key*> _order;  // Keys of `_entries`, most recently stored first.
+    Stats                 _stats;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_DATA_ASSET_CACHE_HPP_
@@ -0,0 +1,86 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#ifndef ANTARES_DATA_COMPILED_SCENARIO_HPP_
+#define ANTARES_DATA_COMPILED_SCENARIO_HPP_
+
+#include <stdint.h>
+#include <map>
+#include <memory>
+#include <pn/data>
+#include <pn/string>
+#include <pn/value>
+#include <sfz/sfz.hpp>
+#include <vector>
+
+namespace antares {
+
+// A binary image of a scenario's procyon files, so that they can be read back without running
+// the text parser over them.  Images are validated against a digest of the sources they were
+// compiled from; an image compiled from other sources is ignored.
+//
+// An image starts with kCompiledScenarioMagic and the 20-byte digest, followed by a number of
+// entries, then each entry: the resource path as a string, followed by the size of the encoded
+// value as a number and the value itself, as encoded by encode_value().
+class CompiledScenario {
+  public:
+    CompiledScenario(const CompiledScenario&) = delete;
+    CompiledScenario& operator=(const CompiledScenario&) = delete;
+
+    // Maps the image at `path`.  Returns nullptr if there is none, if it was compiled from
+    // sources other than those with `digest`, or if it is damaged.
+    static std::unique_ptr<CompiledScenario> open(
+            pn::string_view path, const sfz::sha1::digest& digest);
+
+    // Writes an image of `values`, which are keyed by resource path, to `path`.
+    static void write(
+            pn::string_view path, const sfz::sha1::digest& digest,
+            const std::map<pn::string, pn::value>& values);
+
+    // Returns the value compiled from `resource_path`, or nullopt if it wasn't compiled.
+    sfz::optional<pn::value> get(pn::string_view resource_path) const;
+
+  private:
+    CompiledScenario(pn::string_view path);
+
+    sfz::mapped_file                    _file;
+    std::map<pn::string, pn::data_view> _index;
+};
+
+extern const char kCompiledScenarioMagic[4];
+
+// Encodes procyon values in the style of command logs: a byte for the type, then
+//
+//   'n'                            null
+//   't', 'f'                       true, false
+//   'i' <number>                   an integer, zigzag-encoded
+//   'd' <8 bytes>                  a float, as its IEEE 754 bits, least significant first
+//   's' <string>, 'x' <string>     a string, or data
+//   'a' <n> <value>*n              an array
+//   'm' <n> (<string> <value>)*n   a map
+//
+// Numbers are varints, and strings are a number of bytes followed by the bytes.
+void encode_value(pn::value_cref x, std::vector<uint8_t>* out);
+
+// Decodes a value written by encode_value().  Throws std::runtime_error if `in` is malformed.
+pn::value decode_value(pn::data_view in);
+
+}  // namespace antares
+
+#endif  // ANTARES_DATA_COMPILED_SCENARIO_HPP_
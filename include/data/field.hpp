@@ -19,6 +19,8 @@
 #ifndef ANTARES_DATA_FIELD_HPP_
 #define ANTARES_DATA_FIELD_HPP_
 
+#include <algorithm>
+#include <initializer_list>
 #include <pn/fwd>
 #include <pn/string>
 #include <pn/value>
@@ -211,8 +213,13 @@ struct field {
             : set([field](T* t, path_value x) { (t->*field) = read_field<F>(x); }) {}
 };
 
+// The fields of a struct, in the order they are read.  Passed as an initializer list, so that
+// reading a struct, which happens once per sprite frame, action, and so on, doesn't allocate.
 template <typename T>
-T required_struct(path_value x, const std::map<pn::string_view, field<T>>& fields) {
+using field_list = std::initializer_list<std::pair<pn::string_view, field<T>>>;
+
+template <typename T>
+T required_struct(path_value x, field_list<T> fields) {
     if (x.value().is_map()) {
         T t;
         for (const auto& kv : fields) {
@@ -220,9 +227,12 @@ T required_struct(path_value x, const std::map<pn::string_view, field<T>>& field
             kv.second.set(&t, v);
         }
         for (auto kv : x.value().as_map()) {
-            pn::string_view k = kv.key();
-            path_value      v = x.get(k);
-            if (fields.find(k) == fields.end()) {
+            pn::string_view k     = kv.key();
+            auto            known = [k](const std::pair<pn::string_view, field<T>>& f) {
+                return f.first == k;
+            };
+            if (std::find_if(fields.begin(), fields.end(), known) == fields.end()) {
+                path_value v = x.get(k);
                 throw std::runtime_error(pn::format("{0}unknown field", v.prefix()).c_str());
             }
         }
@@ -233,7 +243,7 @@ T required_struct(path_value x, const std::map<pn::string_view, field<T>>& field
 }
 
 template <typename T>
-sfz::optional<T> optional_struct(path_value x, const std::map<pn::string_view, field<T>>& fields) {
+sfz::optional<T> optional_struct(path_value x, field_list<T> fields) {
     if (x.value().is_null()) {
         return sfz::nullopt;
     } else if (x.value().is_map()) {
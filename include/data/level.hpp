@@ -150,6 +150,15 @@ union Level {
 };
 Level level(pn::value_cref x);
 
+// The little that the level menus need to know about a level.  Reading it skips the initials,
+// conditions, and briefings, which make up most of a level.
+struct LevelInfo {
+    LevelBase::Type        type = LevelBase::Type::DEMO;
+    sfz::optional<int64_t> chapter;
+    pn::string             name;
+};
+LevelInfo level_info(pn::value_cref x);
+
 }  // namespace antares
 
 #endif  // ANTARES_DATA_LEVEL_HPP_
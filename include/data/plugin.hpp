@@ -20,6 +20,7 @@
 #define ANTARES_DATA_PLUGIN_HPP_
 
 #include <map>
+#include <pn/value>
 #include <sfz/sfz.hpp>
 #include <vector>
 
@@ -34,18 +35,23 @@ class ZipArchive;
 namespace antares {
 
 class BaseObject;
+class CompiledScenario;
 union Level;
+struct LevelInfo;
 struct Race;
 
 struct ScenarioGlobals {
     sfz::optional<pn::string>          dir;
     std::unique_ptr<zipxx::ZipArchive> zip;
+    std::unique_ptr<CompiledScenario>  compiled;
 
     Info                             info;
-    std::map<int, const Level*>      chapters;
-    std::map<pn::string, Level>      levels;
+    std::map<int, pn::string>        chapters;     // Names of levels, by chapter.
+    std::map<pn::string, LevelInfo>  level_index;  // Every level in the scenario.
+    std::map<pn::string, Level>      levels;       // Levels read so far; see Level::get().
     std::map<pn::string, BaseObject> objects;
     std::map<pn::string, Race>       races;
+    std::map<pn::string, pn::value>  templates;  // Merged objects that others are based on.
 
     Texture splash;
     Texture starmap;
@@ -58,6 +64,10 @@ void PluginInit(sfz::optional<pn::string_view> path);
 void load_race(const NamedHandle<const Race>& r);
 void load_object(const NamedHandle<const BaseObject>& o);
 
+// Unloads all races and objects, as at the start of a level.  Objects are kept in a cache, so
+// that loading them again for a later level doesn't need to re-read them.
+void unload_objects();
+
 }  // namespace antares
 
 #endif  // ANTARES_DATA_PLUGIN_HPP_
@@ -20,6 +20,7 @@
 #define ANTARES_DATA_RESOURCE_HPP_
 
 #include <stdint.h>
+#include <memory>
 #include <pn/string>
 #include <vector>
 
@@ -27,10 +28,12 @@ namespace antares {
 
 class ArrayPixMap;
 class BaseObject;
+class CompiledScenario;
 class NatePixTable;
 class Texture;
 struct Info;
 struct InterfaceData;
+struct LevelInfo;
 struct FontData;
 union Level;
 struct Race;
@@ -44,11 +47,25 @@ class Resource {
     static std::vector<pn::string> list_replays();
     static bool                    object_exists(pn::string_view name);
 
+    // Finds every resource of the current plugin, the factory scenario, and the application
+    // once, so that later lookups needn't probe each of those places in turn.
+    static void index();
+
+    // Drops zip entries kept decompressed since they were last read.  Must be called before the
+    // plugin's archive is closed.
+    static void flush();
+
+    // Returns a binary image of the scenario's levels, objects, races, and sprite data, kept at
+    // `cache_path`, for procyon reads to use instead of parsing text.  The image is compiled
+    // again if it is missing or stale.  Returns nullptr if it can't be written.
+    static std::unique_ptr<CompiledScenario> compiled(pn::string_view cache_path);
+
     static FontData                font(pn::string_view name);
     static Texture                 font_image(pn::string_view name);
     static Info                    info();
     static InterfaceData           interface(pn::string_view name);
     static Level                   level(pn::string_view path);
+    static LevelInfo               level_info(pn::string_view path);
     static SoundData               music(pn::string_view name);
     static BaseObject              object(pn::string_view path);
     static Race                    race(pn::string_view path);
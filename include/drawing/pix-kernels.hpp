@@ -0,0 +1,48 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#ifndef ANTARES_DRAWING_PIX_KERNELS_HPP_
+#define ANTARES_DRAWING_PIX_KERNELS_HPP_
+
+#include <stdint.h>
+
+#include "drawing/color.hpp"
+
+namespace antares {
+
+// Loops over single rows of pixels, for the PixMap operations that sprite loading and snapshots
+// spend their time in.  Each uses SSE2 or NEON where the target has it, and plain loops
+// otherwise; the results are the same either way.
+
+// Draws a sprite overlay over `width` pixels of `dst`.  The red channel of each overlay pixel is
+// a shade, which is looked up in `tints` (see `RgbColor::tint()`); its alpha channel gives how
+// much of the tinted color to mix into `dst`.  The alpha channel of `dst` is kept.
+void overlay_row(RgbColor* dst, const RgbColor* overlay, const RgbColor (&tints)[256], int width);
+
+// Draws `width` pixels of `src` over `dst`, as PixMap::composite() does.  Runs of opaque source
+// pixels, and of clear ones over opaque destination pixels, are handled four at a time; other
+// pixels are mixed one at a time, in floating point.
+void composite_row(RgbColor* dst, const RgbColor* src, int width);
+
+// Converts `width` pixels of 4-byte BGRA data into opaque colors, ignoring the input's alpha.
+void bgra_row(RgbColor* dst, const uint8_t* bgra, int width);
+
+}  // namespace antares
+
+#endif  // ANTARES_DRAWING_PIX_KERNELS_HPP_
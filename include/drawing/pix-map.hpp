@@ -22,6 +22,7 @@
 #include <memory>
 #include <pn/input>
 #include <pn/output>
+#include <sfz/sfz.hpp>
 
 #include "drawing/color.hpp"
 #include "math/geometry.hpp"
@@ -140,6 +141,10 @@ class PixMap {
     //
     // @param [in] out      the file to write to
     void encode(pn::output_view out);
+
+    // Returns the SHA-1 digest of the pixels, as red, green, blue, and alpha bytes, row by row
+    // from the top.  PixMaps with the same pixels have the same digest, however they're stored.
+    sfz::sha1::digest digest() const;
 };
 
 // PixMap subclass which provides its own storage.
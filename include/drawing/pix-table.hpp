@@ -19,6 +19,7 @@
 #ifndef ANTARES_DRAWING_PIX_TABLE_HPP_
 #define ANTARES_DRAWING_PIX_TABLE_HPP_
 
+#include <memory>
 #include <vector>
 
 #include "drawing/pix-map.hpp"
@@ -26,11 +27,24 @@
 
 namespace antares {
 
+// Whether a NatePixTable keeps CPU-side copies of its frames once they are uploaded as textures.
+//
+// RESIDENT tables hold the pixels of every frame for as long as the table lives.  DISCARD tables
+// free them as soon as the texture is built; `Frame::pix_map()` then re-reads the sprite resource
+// on demand, which is slow, but rare outside of tools and tests.
+enum class PixResidency { RESIDENT, DISCARD };
+
 class NatePixTable {
   public:
     class Frame;
+    struct Decoded;
+
+    // Reads and tints the frames of sprite `name`.  Doesn't touch the video driver, so unlike
+    // the constructors, it is safe to call from any thread.
+    static Decoded decode(pn::string_view name, Hue hue);
 
-    NatePixTable(pn::string_view name, Hue hue);
+    NatePixTable(pn::string_view name, Hue hue, PixResidency residency = PixResidency::RESIDENT);
+    NatePixTable(Decoded decoded, PixResidency residency = PixResidency::RESIDENT);
     NatePixTable(const NatePixTable&) = delete;
     NatePixTable(NatePixTable&&)      = default;
     NatePixTable& operator=(const NatePixTable&) = delete;
@@ -41,15 +55,25 @@ class NatePixTable {
     size_t       size() const;
 
   private:
-    size_t             _size;
     std::vector<Frame> _frames;
 };
 
+// The frames of a sprite, ready to be uploaded as textures.
+struct NatePixTable::Decoded {
+    struct Frame {
+        Rect                         bounds;
+        std::unique_ptr<ArrayPixMap> pix_map;
+    };
+
+    pn::string         name;
+    Hue                hue;
+    std::vector<Frame> frames;
+};
+
 class NatePixTable::Frame {
   public:
-    Frame(Rect bounds, const PixMap& image, pn::string_view name, int frame);
-    Frame(Rect bounds, const PixMap& image, pn::string_view name, int frame, const PixMap& overlay,
-          Hue hue);
+    Frame(Rect bounds, std::unique_ptr<ArrayPixMap> pix_map, pn::string_view name, int frame,
+          Hue hue, PixResidency residency);
     Frame(Frame&&) = default;
     ~Frame();
 
@@ -61,13 +85,14 @@ class NatePixTable::Frame {
     const Texture& texture() const;
 
   private:
-    void load_image(const PixMap& pix);
-    void load_overlay(const PixMap& pix, Hue hue);
-    void build(pn::string_view name, int frame);
+    void build(PixResidency residency);
 
-    Rect        _bounds;
-    ArrayPixMap _pix_map;
-    Texture     _texture;
+    Rect                                 _bounds;
+    pn::string                           _name;
+    int                                  _frame;
+    Hue                                  _hue;
+    mutable std::unique_ptr<ArrayPixMap> _pix_map;
+    Texture                              _texture;
 };
 
 }  // namespace antares
@@ -20,7 +20,10 @@
 #define ANTARES_DRAWING_SPRITE_HANDLING_HPP_
 
 #include <map>
+#include <memory>
+#include <vector>
 
+#include "data/asset-cache.hpp"
 #include "data/base-object.hpp"
 #include "data/handle.hpp"
 #include "drawing/color.hpp"
@@ -41,6 +44,9 @@ const Scale   kBlipThreshhold = kOneQuarterScale;
 
 const size_t MAX_PIX_SIZE = 480;
 
+// How many bytes of sprites to keep cached between levels.
+const size_t kPixCacheBytes = 64 << 20;
+
 const size_t  kMaxPixTableEntry = 60;
 const int32_t kNoSprite         = -1;
 
@@ -57,6 +63,7 @@ class Sprite {
     Sprite();
 
     Point             where;
+    Point             last_where;  // `where` as of the previous tick.
     NatePixTable*     table;
     int               whichShape;
     Scale             scale;
@@ -80,16 +87,39 @@ class Sprite {
 
 extern Scale gAbsoluteScale;
 
+// The sprite tables in use by the current level.  When a level ends, its tables are kept in a
+// cache, budgeted by the size of their pixels, so that the next level can reuse them instead of
+// decoding, tinting, and uploading them again.
+//
+// While a level loads, tables can also be loaded in a batch: `request()` each table the level
+// needs, then `start_loading()` to decode and tint them all on background threads, and
+// `finish_loading()` to upload them, one share at a time, as they become ready.  `ready()` tells
+// whether `finish_loading()` can upload a share without waiting.
 class Pix {
   public:
+    typedef std::pair<pn::string, Hue> Key;
+
+    Pix();
+    ~Pix();
+
     void                reset();
-    NatePixTable*       add(pn::string_view id, Hue hue);
+    void                flush();
     NatePixTable*       get(pn::string_view id, Hue hue);
     const NatePixTable* cursor();
 
+    void request(pn::string_view id, Hue hue);
+    void start_loading();
+    bool ready(int part, int parts) const;
+    void finish_loading(int part, int parts);  // Uploads share `part` of [0, parts).
+
   private:
-    std::map<std::pair<pn::string, Hue>, NatePixTable> _pix;
-    std::unique_ptr<NatePixTable>                      _cursor;
+    class Loader;
+
+    std::map<Key, NatePixTable>   _pix;
+    std::unique_ptr<NatePixTable> _cursor;
+    AssetCache<Key, NatePixTable> _cache{kPixCacheBytes};
+    std::vector<Key>              _requested;
+    std::unique_ptr<Loader>       _loader;
 };
 
 void           SpriteHandlingInit();
@@ -101,6 +131,19 @@ Handle<Sprite> AddSprite(
         uint8_t tiny_shade);
 void RemoveSprite(Handle<Sprite> sprite);
 void draw_sprites();
+
+// When frames are drawn more often than the simulation ticks, things that move are drawn part of
+// the way from where they were as of the previous tick to where they are now.  Positions are
+// interpolated in screen space, so frames drawn after the zoom has changed since the previous
+// tick draw everything where it is now.
+//
+// `remember_sprite_positions()` is called before each simulation step, along with the other
+// `remember_positions()` functions.  `set_tick_fraction()` sets how far between the two ticks to
+// draw the next frame, from 0 (as of the previous tick) to 1 (as of the current one), and
+// `tick_position()` interpolates a position for that frame.
+void  remember_sprite_positions();
+void  set_tick_fraction(Fixed fraction);
+Point tick_position(Point last, Point now);
 void CullSprites();
 
 }  // namespace antares
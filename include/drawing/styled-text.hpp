@@ -19,7 +19,6 @@
 #ifndef ANTARES_DRAWING_STYLED_TEXT_HPP_
 #define ANTARES_DRAWING_STYLED_TEXT_HPP_
 
-#include <map>
 #include <pn/string>
 #include <utility>
 #include <vector>
@@ -89,6 +88,15 @@ class StyledText {
 
     pn::string_view     text() const;
     void                select(int from, int to);
+
+    // Replaces the bytes in [from, to) of `text()` with `text`, which is interpreted as plain
+    // text in the style of the character at `from`.  Layout is redone only from the start of
+    // the paragraph containing `from`.
+    void replace(int from, int to, pn::string_view text);
+
+    // Equivalent to replacing the differing middle part of `text()` with that of `text`.
+    void set_text(pn::string_view text);
+
     std::pair<int, int> selection() const;
     void                mark(int from, int to);
     std::pair<int, int> mark() const;
@@ -112,9 +120,10 @@ class StyledText {
 
     struct StyledChar {
         StyledChar(
-                SpecialChar special, int pict_index, const RgbColor& fore_color,
+                int offset, SpecialChar special, int pict_index, const RgbColor& fore_color,
                 const RgbColor& back_color);
 
+        int         offset;  // of the character in `_text`.
         SpecialChar special;
         int         pict_index;
         RgbColor    fore_color;
@@ -122,9 +131,28 @@ class StyledText {
         Rect        bounds;
     };
 
-    void rewrap();
-    int  move_word_down(std::map<pn::string::iterator, StyledChar>::iterator it, int v);
-    bool is_selected(std::map<pn::string::iterator, StyledChar>::const_iterator it) const;
+    // Layout state at the start of a paragraph, used to resume rewrap() after an edit.
+    struct Paragraph {
+        int start;  // index into `_chars`.
+        int v;
+        int auto_width;
+    };
+
+    // A visual line of `_chars`, from `start` up to the start of the next line.
+    struct Line {
+        int start;  // index into `_chars`.
+        int top;
+    };
+
+    static SpecialChar plain_special(pn::rune r);
+
+    void     rewrap(int start = 0);
+    int      move_word_down(int index, int v);
+    bool     is_selected(int index) const;
+    pn::rune rune_at(int index) const;
+    int      char_index(int offset) const;
+    int      line_index(int index) const;
+    int      closest_in_line(int line, int h, bool rightmost) const;
 
     bool is_line_start(
             pn::string::iterator begin, pn::string::iterator end, pn::string::iterator it) const;
@@ -136,18 +164,20 @@ class StyledText {
     bool is_end(
             pn::string::iterator begin, pn::string::iterator end, pn::string::iterator it,
             TextReceiver::OffsetUnit unit) const;
-    pn::string::iterator line_up(pn::string::iterator it) const;
-    pn::string::iterator line_down(pn::string::iterator it) const;
-
-    pn::string                                                  _text;
-    std::unique_ptr<std::map<pn::string::iterator, StyledChar>> _chars;
-    std::vector<inlinePictType>                                 _inline_picts;
-    std::vector<Texture>                                        _textures;
-    WrapMetrics                                                 _wrap_metrics;
-    std::map<pn::string::iterator, StyledChar>::const_iterator  _until;
-    Size                                                        _auto_size;
-    std::pair<int, int>                                         _selection = {-1, -1};
-    std::pair<int, int>                                         _mark      = {-1, -1};
+    int line_up(int offset) const;
+    int line_down(int offset) const;
+
+    pn::string                  _text;
+    std::vector<StyledChar>     _chars;  // ordered by offset.
+    std::vector<Paragraph>      _paragraphs;
+    std::vector<Line>           _lines;
+    std::vector<inlinePictType> _inline_picts;
+    std::vector<Texture>        _textures;
+    WrapMetrics                 _wrap_metrics;
+    int                         _until = 0;
+    Size                        _auto_size;
+    std::pair<int, int>         _selection = {-1, -1};
+    std::pair<int, int>         _mark      = {-1, -1};
 };
 
 }  // namespace antares
@@ -19,7 +19,10 @@
 #ifndef ANTARES_DRAWING_TEXT_HPP_
 #define ANTARES_DRAWING_TEXT_HPP_
 
+#include <array>
 #include <pn/string>
+#include <unordered_map>
+#include <vector>
 
 #include "drawing/sprite-handling.hpp"
 #include "lang/casts.hpp"
@@ -52,9 +55,33 @@ class Font {
     int32_t ascent       = 0;
 
   private:
-    Rect glyph_rect(pn::rune rune) const;
+    // Glyphs for U+0000 through U+00FF are looked up in `_latin` rather than `_glyphs`.  That
+    // covers all of the ASCII text drawn in game, as well as everything that MacRoman-derived
+    // scenario text usually needs.
+    static const int kLatinGlyphs = 0x100;
 
-    std::map<pn::rune, Rect> _glyphs;
+    // Maximum number of entries in `_runs`.  When full, the cache is flushed and rebuilt from
+    // whatever is drawn next; the strings drawn in any one frame should fit comfortably.
+    static const size_t kMaxGlyphRuns = 512;
+
+    struct Glyph {
+        Rect dest;    // relative to the cursor, after adjusting for `ascent`.
+        Rect source;  // within `texture`.
+    };
+
+    // A string, laid out once and then redrawn from the layout on later frames.
+    struct GlyphRun {
+        pn::string         text;
+        std::vector<Glyph> glyphs;
+    };
+
+    Rect            glyph_rect(pn::rune rune) const;
+    Rect            find_glyph(pn::rune rune) const;
+    const GlyphRun& glyph_run(pn::string_view s) const;
+
+    std::map<pn::rune, Rect>                       _glyphs;
+    std::array<Rect, kLatinGlyphs>                 _latin;
+    mutable std::unordered_map<uint64_t, GlyphRun> _runs;
 };
 
 Font font(pn::string_view name);
@@ -45,6 +45,7 @@ class Label {
     static void update_contents(ticks units_done);
     static void update_positions(ticks units_done);
     static void show_all();
+    static void remember_positions();
 
     void remove();
 
@@ -70,6 +71,7 @@ class Label {
     Point               where;
     Point               offset;
     Rect                thisRect = Rect(0, 0, -1, -1);
+    Rect                lastRect = Rect(0, 0, -1, -1);
     ticks               age      = ticks(0);
     StyledText          _text;
     Hue                 hue;
@@ -40,6 +40,7 @@ struct LoadState {
 
 LoadState start_construct_level(const Level& level);
 void      construct_level(LoadState* state);
+bool      construct_level_ready(const LoadState& state);  // Whether the next step won't block.
 void      DeclareWinner(Handle<Admiral> whichPlayer, const Level* nextLevel, pn::string_view text);
 void      GetLevelFullScaleAndCorner(int32_t rotation, Point* corner, Scale* scale, Rect* bounds);
 Point     Translate_Coord_To_Level_Rotation(int32_t h, int32_t v);
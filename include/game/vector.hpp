@@ -58,6 +58,7 @@ struct Vector {
     int32_t             accuracy;
     int32_t             range;
     Point               thisBoltPoint[kBoltPointNum];
+    Point               lastBoltPoint[kBoltPointNum];
 
   private:
     friend class Vectors;
@@ -74,6 +75,7 @@ class Vectors {
     static void update();
     static void draw();
     static void cull();
+    static void remember_positions();
 };
 
 }  // namespace antares
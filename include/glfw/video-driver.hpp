@@ -48,6 +48,7 @@ class GLFWVideoDriver : public OpenGlVideoDriver {
     virtual void stop_editing(TextReceiver* text);
 
     virtual wall_time now() const;
+    virtual bool      real_time() const { return true; }
 
     void loop(Card* initial);
 
@@ -59,12 +60,14 @@ class GLFWVideoDriver : public OpenGlVideoDriver {
     void        mouse_move(double x, double y);
     void        window_size(int width, int height);
     void        window_maximize(bool maximized);
+    void        wait_events(wall_time until);
     static void key_callback(GLFWwindow* w, int key, int scancode, int action, int mods);
     static void char_callback(GLFWwindow* w, unsigned int code_point);
     static void mouse_button_callback(GLFWwindow* w, int button, int action, int mods);
     static void mouse_move_callback(GLFWwindow* w, double x, double y);
     static void window_size_callback(GLFWwindow* w, int width, int height);
     static void window_maximize_callback(GLFWwindow* w, int maximized);
+    static void window_refresh_callback(GLFWwindow* w);
 
     bool          _fullscreen;
     Size          _screen_size;
@@ -74,6 +77,7 @@ class GLFWVideoDriver : public OpenGlVideoDriver {
     wall_time     _last_click_usecs;
     int           _last_click_count;
     TextReceiver* _text;
+    bool          _redraw;
 };
 
 }  // namespace antares
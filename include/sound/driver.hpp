@@ -35,6 +35,9 @@ class Sound {
 
     virtual void play(uint8_t volume) = 0;
     virtual void loop(uint8_t volume) = 0;
+
+    // How many bytes of samples the sound holds, for budgeting caches of sounds.
+    virtual size_t bytes() const { return 0; }
 };
 
 class SoundChannel {
@@ -21,16 +21,24 @@
 
 #include <stdint.h>
 
+#include <memory>
+#include <pn/string>
 #include <vector>
 
+#include "data/asset-cache.hpp"
 #include "data/handle.hpp"
 #include "math/fixed.hpp"
 #include "math/units.hpp"
 
 namespace antares {
 
+class Sound;
+
 const int32_t kMaxVolumePreference = 8;
 
+// How many bytes of sounds to keep cached between levels.
+const size_t kSoundCacheBytes = 16 << 20;
+
 class SoundFX {
   public:
     SoundFX();
@@ -39,6 +47,7 @@ class SoundFX {
     void init();
     void load(pn::string_view id);
     void reset();
+    void flush();
     void stop();
 
     void play(pn::string_view id, uint8_t volume, usecs persistence, uint8_t priority);
@@ -79,6 +88,9 @@ class SoundFX {
 
     std::vector<smartSoundHandle>  sounds;
     std::vector<smartSoundChannel> channels;
+
+    // Sounds loaded for previous levels, kept so that later levels can reuse them.
+    AssetCache<pn::string, std::unique_ptr<Sound>> _cache;
 };
 
 }  // namespace antares
@@ -21,8 +21,10 @@
 
 #include <memory>
 
+#include "math/geometry.hpp"
 #include "math/units.hpp"
 #include "ui/event.hpp"
+#include "video/driver.hpp"
 
 namespace antares {
 
@@ -123,6 +125,15 @@ class Card : public EventReceiver {
     // @returns             The Card below this one.
     Card* next() const;
 
+    // Draws the card below this one, for cards that cover it only in part.
+    //
+    // Cards below the front-most one receive no events or timers, so they look the same from one
+    // frame to the next.  The first call draws the card below and keeps a copy of the result,
+    // taken with `VideoDriver::capture()`.  Later calls draw the copy instead.  The copy is
+    // dropped when this card becomes front-most again, or when the screen changes size.  If the
+    // driver can't capture, the card below is drawn every time.
+    void draw_next() const;
+
   private:
     friend class CardStack;
 
@@ -132,6 +143,11 @@ class Card : public EventReceiver {
     // The next card down on the stack.  Is NULL for the bottom-most card, and non-NULL for every
     // card above it.
     std::unique_ptr<Card> _next;
+
+    // The copy of the card below that `draw_next()` draws, and the screen it was taken from.
+    mutable Texture _next_image;
+    mutable Size    _next_image_size;
+    mutable int     _next_image_scale = 0;
 };
 
 // A stack of Card objects that constitutes an application.
@@ -73,6 +73,7 @@ class InterfaceScreen : public Card {
     void      set_state(
                  State state, Widget* widget = nullptr, Key key = Key::NONE,
                  Gamepad::Button gamepad = Gamepad::Button::NONE);
+    void draw_widgets() const;
 
     const Rect                           _bounds;
     bool                                 _full_screen = false;
@@ -81,6 +82,17 @@ class InterfaceScreen : public Card {
     Key                                  _key_pressed     = Key::NONE;
     Gamepad::Button                      _gamepad_pressed = Gamepad::Button::NONE;
     Cursor                               _cursor;
+
+    // A copy of the screen as of the last time the widgets were drawn, before the overlay and
+    // cursor, with what it depended on.  While none of that changes, draw() shows the copy.
+    struct WidgetImage {
+        Texture               texture;
+        Size                  screen_size;
+        int                   scale = 0;
+        InputMode             mode  = KEYBOARD_MOUSE;
+        std::vector<uint64_t> states;
+    };
+    mutable WidgetImage _image;
 };
 
 }  // namespace antares
@@ -49,6 +49,10 @@ class Widget {
     virtual Rect inner_bounds() const                     = 0;
     virtual Rect outer_bounds() const                     = 0;
 
+    // Summarizes what, besides its layout, decides how the widget draws: whether it's pressed,
+    // enabled, checked, and so on.  If a widget's state is unchanged, then so is its appearance.
+    virtual uint64_t state() const;
+
     virtual std::vector<const Widget*> children() const;
     virtual std::vector<Widget*>       children();
 };
@@ -132,6 +136,7 @@ class Button : public Widget {
     InterfaceStyle  style() const { return _style; }
     bool            active() const { return _active; }
     virtual bool    enabled() const = 0;
+    uint64_t        state() const override;
 
     Key& key() { return _key; }
     Hue& hue() { return _hue; }
@@ -185,6 +190,7 @@ class CheckboxButton : public Button {
     bool         get() const;
     void         set(bool on);
     bool         enabled() const override;
+    uint64_t     state() const override;
     virtual void action() override;
 
     void draw(Point origin, InputMode mode) const override;
@@ -200,9 +206,10 @@ class RadioButton : public Button {
   public:
     RadioButton(const RadioButtonData& data);
 
-    bool  on() const { return _on; }
-    bool& on() { return _on; }
-    bool  enabled() const override { return false; }
+    bool     on() const { return _on; }
+    bool&    on() { return _on; }
+    bool     enabled() const override { return false; }
+    uint64_t state() const override;
 
     void draw(Point origin, InputMode mode) const override;
     Rect inner_bounds() const override;
@@ -222,6 +229,7 @@ class TabButton : public Button {
     bool                                        on() const { return _on; }
     bool&                                       on() { return _on; }
     bool                                        enabled() const override { return true; }
+    uint64_t                                    state() const override;
     virtual void                                action() override;
 
     void draw(Point origin, InputMode mode) const override;
@@ -249,6 +257,7 @@ class TabBox : public Widget {
     Rect inner_bounds() const override;
     Rect outer_bounds() const override;
 
+    uint64_t                   state() const override;
     std::vector<const Widget*> children() const override;
     std::vector<Widget*>       children() override;
 
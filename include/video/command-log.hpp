@@ -0,0 +1,113 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_VIDEO_COMMAND_LOG_HPP_
+#define ANTARES_VIDEO_COMMAND_LOG_HPP_
+
+#include <stdint.h>
+#include <functional>
+#include <pn/data>
+#include <pn/output>
+#include <pn/string>
+#include <vector>
+
+#include "drawing/color.hpp"
+
+namespace antares {
+
+// Formats the draw commands of one frame as text, the way TextVideoDriver snapshots them: one
+// line per command, with tab-separated fields.  A field that repeats the same field of the line
+// above is left blank.
+//
+// A line is formatted by calling begin(), then arg() once per argument, then end().  Fields are
+// formatted straight into `out`, and into one buffer for comparing with the next line, so no
+// string is allocated per field.
+class CommandText {
+  public:
+    // Forgets the previous line, as at the start of a frame.
+    void reset() {
+        _last.clear();
+        _last_ends.clear();
+    }
+
+    void begin(pn::string_view command, pn::string& out);
+    void arg(int i);
+    void arg(pn::string_view s);
+    void arg(const RgbColor& c);
+    void end();
+
+  private:
+    void field(pn::string_view s);
+
+    pn::string*      _out = nullptr;
+    bool             _new_command;
+    pn::string       _last, _this;            // fields of the previous and current lines
+    std::vector<int> _last_ends, _this_ends;  // where each field in `_last` or `_this` ends
+};
+
+// Writes draw commands in a compact binary form, as they are produced, instead of formatting
+// them.  decode_command_log() turns the result back into the snapshots that TextVideoDriver
+// would have written.
+//
+// The log starts with kCommandLogMagic, and is followed by records, each starting with a byte:
+//
+//   'F'                        a new frame
+//   'C' <string> <n> <arg>*n   a command with `n` arguments
+//   'S' <string>               a snapshot of the current frame, to the given relative path
+//
+// Numbers are varints, in the style of protocol buffers; strings are a number of bytes followed
+// by the bytes.  An argument is one of:
+//
+//   'i' <number>               an integer, zigzag-encoded
+//   's' <string>               a string
+//   'c' <r> <g> <b> <a>        a color, one byte per channel
+class CommandLogWriter {
+  public:
+    CommandLogWriter(pn::output out);
+    CommandLogWriter(const CommandLogWriter&) = delete;
+    CommandLogWriter& operator=(const CommandLogWriter&) = delete;
+    ~CommandLogWriter();
+
+    void frame();
+    void command(pn::string_view name, int argc);
+    void arg(int i);
+    void arg(pn::string_view s);
+    void arg(const RgbColor& c);
+    void snapshot(pn::string_view relpath);
+
+  private:
+    void byte(uint8_t b) { _buffer.push_back(b); }
+    void number(uint64_t n);
+    void string(pn::string_view s);
+    void flush();
+
+    pn::output           _out;
+    std::vector<uint8_t> _buffer;
+};
+
+extern const char kCommandLogMagic[4];
+
+// Calls `snapshot(relpath, text)` for each snapshot recorded in `log`.  Throws
+// std::runtime_error if `log` is malformed.
+void decode_command_log(
+        pn::data_view                                                log,
+        const std::function<void(pn::string_view, pn::string_view)>& snapshot);
+
+}  // namespace antares
+
+#endif  // ANTARES_VIDEO_COMMAND_LOG_HPP_
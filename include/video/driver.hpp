@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <memory>
 #include <pn/string>
+#include <vector>
 
 #include "drawing/color.hpp"
 #include "math/geometry.hpp"
@@ -65,6 +66,10 @@ class VideoDriver {
 
     virtual wall_time now() const = 0;
 
+    // True if now() follows the wall clock.  Drivers which simulate the clock draw one frame per
+    // tick, so that their output doesn't depend on how fast they run.
+    virtual bool real_time() const { return false; }
+
     virtual Texture texture(pn::string_view name, const PixMap& content, int scale)      = 0;
     virtual void    dither_rect(const Rect& rect, const RgbColor& color)                 = 0;
     virtual void    draw_point(const Point& at, const RgbColor& color)                   = 0;
@@ -73,6 +78,10 @@ class VideoDriver {
     virtual void    draw_diamond(const Rect& rect, const RgbColor& color)                = 0;
     virtual void    draw_plus(const Rect& rect, const RgbColor& color)                   = 0;
 
+    // Returns a copy of everything drawn so far in the current frame, the size of the screen, or
+    // nullptr if the driver can't make one.  Drawing the copy replaces what's beneath it.
+    virtual Texture capture();
+
   private:
     friend class Points;
     friend class Lines;
@@ -226,11 +235,23 @@ class Lines {
     void draw(const Point& from, const Point& to, const RgbColor& color) const;
 };
 
+struct FilledRect {
+    Rect     rect;
+    RgbColor color;
+};
+
 class Rects {
   public:
     Rects();
+    // Appends fills to `*recording` instead of drawing them, to be replayed later with
+    // fill(*recording).
+    explicit Rects(std::vector<FilledRect>* recording);
     ~Rects();
     void fill(const Rect& rect, const RgbColor& color) const;
+    void fill(const std::vector<FilledRect>& rects) const;
+
+  private:
+    std::vector<FilledRect>* _recording = nullptr;
 };
 
 class Quads {
@@ -49,9 +49,20 @@ class OffscreenVideoDriver : public OpenGlVideoDriver {
     void capture(std::vector<std::pair<std::unique_ptr<Card>, pn::string>>& pix);
     void set_capture_rect(Rect r) { _capture_rect = r; }
 
+    // Instead of writing each snapshot to a PNG in the output directory, appends it to `path`
+    // as a frame of raw video: 4 bytes per pixel in BGRA order, rows from top to bottom, and
+    // no headers.  `path` may be a pipe, such as the input of an encoder.
+    void set_video_output(pn::string_view path) { _video_path.emplace(path.copy()); }
+
+    // Instead of writing each snapshot to a PNG, appends its path and the SHA-1 digest of its
+    // pixels to hashes.txt in the output directory.
+    void set_hash_only(bool hash_only) { _hash_only = hash_only; }
+
   private:
     const Size                _screen_size;
     sfz::optional<pn::string> _output_dir;
+    sfz::optional<pn::string> _video_path;
+    bool                      _hash_only = false;
     Rect                      _capture_rect;
 
     EventScheduler* _scheduler = nullptr;
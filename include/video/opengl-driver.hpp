@@ -21,6 +21,7 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
 
 #include "drawing/color.hpp"
 #include "math/geometry.hpp"
@@ -57,6 +58,7 @@ class OpenGlVideoDriver : public VideoDriver {
     virtual int scale() const;
 
     virtual Texture texture(pn::string_view name, const PixMap& content, int scale);
+    virtual Texture capture();
     virtual void    dither_rect(const Rect& rect, const RgbColor& color);
     virtual void    draw_point(const Point& at, const RgbColor& color);
     virtual void    draw_line(const Point& from, const Point& to, const RgbColor& color);
@@ -110,6 +112,13 @@ class OpenGlVideoDriver : public VideoDriver {
     virtual void begin_rects();
     virtual void end_rects();
     virtual void batch_rect(const Rect& rect, const RgbColor& color);
+    void         flush_rects(int color_mode);
+
+    struct RectBatch {
+        int                  depth = 0;
+        std::vector<int16_t> vertices;
+        std::vector<uint8_t> colors;
+    };
 
     Random _static_seed;
 
@@ -119,7 +128,8 @@ class OpenGlVideoDriver : public VideoDriver {
     std::map<size_t, Texture> _diamonds;
     std::map<size_t, Texture> _pluses;
 
-    uint32_t _vbuf[3];
+    uint32_t  _vbuf[3];
+    RectBatch _rects;
 };
 
 }  // namespace antares
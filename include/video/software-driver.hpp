@@ -0,0 +1,89 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_VIDEO_SOFTWARE_DRIVER_HPP_
+#define ANTARES_VIDEO_SOFTWARE_DRIVER_HPP_
+
+#include <map>
+#include <sfz/sfz.hpp>
+#include <vector>
+
+#include "drawing/pix-map.hpp"
+#include "math/random.hpp"
+#include "ui/event-scheduler.hpp"
+#include "video/driver.hpp"
+
+namespace antares {
+
+// Renders into an ArrayPixMap on the CPU, for producing snapshots where there is no OpenGL
+// context available.  Mirrors the fragment shader used by OpenGlVideoDriver, so its snapshots
+// match those of OffscreenVideoDriver, up to rounding.
+class SoftwareVideoDriver : public VideoDriver {
+  public:
+    SoftwareVideoDriver(Size screen_size, const sfz::optional<pn::string>& output_dir);
+
+    virtual Point     get_mouse() { return _scheduler->get_mouse(); }
+    virtual InputMode input_mode() const { return _scheduler->input_mode(); }
+    virtual int       scale() const { return 1; }
+    virtual Size      screen_size() const { return _screen.size(); }
+
+    virtual bool start_editing(TextReceiver* text);
+    virtual void stop_editing(TextReceiver* text);
+
+    virtual wall_time now() const { return _scheduler->now(); }
+
+    virtual Texture texture(pn::string_view name, const PixMap& content, int scale);
+    virtual Texture capture();
+    virtual void    dither_rect(const Rect& rect, const RgbColor& color);
+    virtual void    draw_point(const Point& at, const RgbColor& color);
+    virtual void    draw_line(const Point& from, const Point& to, const RgbColor& color);
+    virtual void    draw_triangle(const Rect& rect, const RgbColor& color);
+    virtual void    draw_diamond(const Rect& rect, const RgbColor& color);
+    virtual void    draw_plus(const Rect& rect, const RgbColor& color);
+
+    void loop(Card* initial, EventScheduler& scheduler);
+    void capture(std::vector<std::pair<std::unique_ptr<Card>, pn::string>>& pix);
+    void set_capture_rect(Rect r) { _capture_rect = r; }
+
+  private:
+    class MainLoop;
+    class TextureImpl;
+
+    virtual void batch_rect(const Rect& rect, const RgbColor& color);
+
+    void fill(Rect rect, const RgbColor& color);
+    void plot(int32_t x, int32_t y, const RgbColor& color);
+
+    ArrayPixMap               _screen;
+    sfz::optional<pn::string> _output_dir;
+    Rect                      _capture_rect;
+
+    Random                     _static_seed;
+    int32_t                    _seed = 0;
+    std::unique_ptr<uint8_t[]> _static_image;
+
+    std::map<size_t, Texture> _triangles;
+    std::map<size_t, Texture> _diamonds;
+    std::map<size_t, Texture> _pluses;
+
+    EventScheduler* _scheduler = nullptr;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_VIDEO_SOFTWARE_DRIVER_HPP_
@@ -24,6 +24,7 @@
 
 #include "config/keys.hpp"
 #include "ui/event-scheduler.hpp"
+#include "video/command-log.hpp"
 #include "video/driver.hpp"
 
 namespace antares {
@@ -53,24 +54,34 @@ class TextVideoDriver : public VideoDriver {
     void loop(Card* initial, EventScheduler& scheduler);
     void capture(std::vector<std::pair<std::unique_ptr<Card>, pn::string>>& pix);
 
+    // Instead of writing out each snapshot's log, appends its path and the SHA-1 digest of the
+    // log to hashes.txt in the output directory.  The log is hashed line by line, never held.
+    void set_hash_only(bool hash_only) { _hash_only = hash_only; }
+
+    // Instead of writing out each snapshot's log, streams all commands and snapshots to
+    // commands.bin in the output directory, unformatted.  decode_command_log() recovers the
+    // snapshots.
+    void set_binary_log(bool binary_log) { _binary_log = binary_log; }
+
   private:
     class MainLoop;
     class TextureImpl;
 
     virtual void batch_rect(const Rect& rect, const RgbColor& color);
 
-    void            add_arg(pn::string_view arg, std::vector<std::pair<size_t, size_t>>& args);
-    void            dup_arg(size_t index, std::vector<std::pair<size_t, size_t>>& args);
-    pn::string_view last_arg(size_t index) const;
-
     template <typename... Args>
     void log(pn::string_view command, const Args&... args);
 
     const Size                _size;
     sfz::optional<pn::string> _output_dir;
-
-    pn::string                             _log;
-    std::vector<std::pair<size_t, size_t>> _last_args;
+    bool                      _hash_only  = false;
+    bool                      _binary_log = false;
+
+    pn::string                      _log;
+    CommandText                     _text;
+    pn::string                      _line;
+    sfz::optional<sfz::sha1>        _hash;
+    sfz::optional<CommandLogWriter> _binary;
 
     EventScheduler* _scheduler = nullptr;
 };
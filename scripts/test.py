@@ -7,6 +7,8 @@
 import argparse
 import collections
 import contextlib
+import filecmp
+import hashlib
 import io
 import multiprocessing.pool
 import os
@@ -17,17 +19,31 @@ import tempfile
 import time
 import traceback
 
+# The software renderer matches the fragment shader up to rounding, so its snapshots may differ
+# from the OpenGL goldens by this much in each channel.
+SOFTWARE_TOLERANCE = 1
+
+# Commands that can write digests of their snapshots with --hash.
+HASH_COMMANDS = ["out/cur/build-pix", "out/cur/offscreen", "out/cur/replay"]
+
 START = "START"
 PASSED = "PASSED"
 FAILED = "FAILED"
 EXCEPT = "EXCEPT"
 
 WINE_TESTS = [
+    "asset-cache-test",
+    "card-test",
     "color-test",
+    "command-log-test",
+    "compiled-scenario-test",
     "editable-text-test",
     "fixed-test",
     "object-data",
+    "pix-kernels-test",
     "shapes",
+    "sprite-handling-test",
+    "styled-text-test",
     "tint",
 ]
 
@@ -49,11 +65,117 @@ def unit_test(opts, queue, name, args=[]):
 
 
 def diff_test(opts, queue, name, cmd, expected):
+    # Software pixels only match within a tolerance, so they can't be compared by digest.
+    exact = ("--text" in cmd) or ("--software" not in cmd)
+    if opts.hash and (cmd[0] in HASH_COMMANDS) and exact:
+        return hash_test(opts, queue, name, cmd, expected)
+    if "--software" in cmd:
+        return tolerance_test(opts, queue, name, cmd, expected)
     with NamedTemporaryDir() as d:
         return (run(opts, queue, name, cmd + ["--output=%s" % d]) and run(
             opts, queue, name, ["diff", "--strip-trailing-cr", "-ru", "-x.*", expected, d]))
 
 
+def hash_test(opts, queue, name, cmd, expected):
+    """Like diff_test(), but has cmd write digests of its snapshots instead of the snapshots.
+
+    Only snapshots whose digests differ from the expected files are written out in full and
+    diffed, in a second run.  Text is compared by the digest of its bytes, and PNGs by the digest
+    of their pixels.
+    """
+    with NamedTemporaryDir() as d:
+        if not run(opts, queue, name, cmd + ["--hash", "--output=%s" % d]):
+            return False
+        mismatched = mismatched_files(opts, expected, d)
+        if not mismatched:
+            return True
+        with NamedTemporaryDir() as full:
+            if not run(opts, queue, name, cmd + ["--output=%s" % full]):
+                return False
+            ok = True
+            for path in mismatched:
+                ok = run(opts, queue, name, [
+                    "diff", "--strip-trailing-cr", "-u", "-N",
+                    os.path.join(expected, path),
+                    os.path.join(full, path)
+                ]) and ok
+            return ok
+
+
+def tolerance_test(opts, queue, name, cmd, expected):
+    """Like diff_test(), but PNGs only have to match within SOFTWARE_TOLERANCE per channel."""
+    with NamedTemporaryDir() as d:
+        if not run(opts, queue, name, cmd + ["--output=%s" % d]):
+            return False
+        ok = True
+        for path in sorted(set(list_files(expected)) | set(list_files(d))):
+            expected_path = os.path.join(expected, path)
+            actual_path = os.path.join(d, path)
+            if path.endswith(".png") and os.path.exists(expected_path) and os.path.exists(
+                    actual_path):
+                ok = run(opts, queue, name, [
+                    "out/cur/compare-png",
+                    "--tolerance=%d" % SOFTWARE_TOLERANCE, expected_path, actual_path
+                ]) and ok
+                continue
+            ok = run(opts, queue, name, [
+                "diff", "--strip-trailing-cr", "-u", "-N", expected_path, actual_path
+            ]) and ok
+        return ok
+
+
+def mismatched_files(opts, expected, actual):
+    hashes = {}
+    with open(os.path.join(actual, "hashes.txt")) as f:
+        for line in f:
+            path, digest = line.rstrip("\n").split("\t")
+            hashes[path] = digest
+
+    expected_files = set(list_files(expected))
+    actual_files = set(list_files(actual)) - {"hashes.txt"}
+    pngs = sorted(p for p in hashes if p.endswith(".png") and (p in expected_files))
+    pixel_hashes = png_digests(opts, expected, pngs)
+    mismatched = []
+    for path in sorted(expected_files | actual_files | set(hashes)):
+        if path in hashes:
+            if path not in expected_files:
+                mismatched.append(path)
+                continue
+            if path in pixel_hashes:
+                digest = pixel_hashes[path]
+            else:
+                with open(os.path.join(expected, path), "rb") as f:
+                    data = f.read().replace(b"\r\n", b"\n")
+                digest = hashlib.sha1(data).hexdigest()
+            if digest != hashes[path]:
+                mismatched.append(path)
+        elif (path not in expected_files) or (path not in actual_files):
+            mismatched.append(path)
+        elif not filecmp.cmp(os.path.join(expected, path), os.path.join(actual, path), False):
+            mismatched.append(path)
+    return mismatched
+
+
+def png_digests(opts, root, paths):
+    """Returns the digests of the pixels of the PNGs at `paths` under `root`, like --hash's."""
+    if not paths:
+        return {}
+    cmd = ["out/cur/hash-png"] + [os.path.join(root, path) for path in paths]
+    if opts.wine:
+        cmd = ["wine", cmd[0] + ".exe"] + cmd[1:]
+    output = subprocess.check_output(cmd).decode("utf-8")
+    digests = [line.rstrip("\r").split("\t")[1] for line in output.splitlines()]
+    return dict(zip(paths, digests))
+
+
+def list_files(root):
+    for dirpath, dirnames, filenames in os.walk(root):
+        dirnames[:] = [d for d in dirnames if not d.startswith(".")]
+        for filename in filenames:
+            if not filename.startswith("."):
+                yield os.path.relpath(os.path.join(dirpath, filename), root)
+
+
 def data_test(opts, queue, name, args=[], smoke_args=[]):
     if opts.smoke:
         args += smoke_args
@@ -69,10 +191,29 @@ def offscreen_test(opts, queue, name, args=[]):
         cmd.append("--text")
         expected = "test/smoke/%s" % name
     else:
+        if opts.software:
+            cmd.append("--software")
         expected = "test/%s" % name
     return diff_test(opts, queue, name, cmd + args, expected)
 
 
+def software_test(opts, queue, name, args=[]):
+    """Runs the offscreen test that `name` names, minus "-software", without OpenGL.
+
+    Its snapshots are compared against the same goldens as the OpenGL ones, within
+    SOFTWARE_TOLERANCE, so the software renderer is covered even when OpenGL is available.
+    """
+    test = name[:-len("-software")]
+    cmd = ["out/cur/offscreen", test]
+    if opts.smoke:
+        cmd.append("--text")
+        expected = "test/smoke/%s" % test
+    else:
+        cmd.append("--software")
+        expected = "test/%s" % test
+    return diff_test(opts, queue, name, cmd + args, expected)
+
+
 def replay_test(opts, queue, name, args=[]):
     cmd = ["out/cur/replay", "test/%s.NLRP" % name, "--text"]
     if opts.smoke:
@@ -83,6 +224,24 @@ def replay_test(opts, queue, name, args=[]):
     return diff_test(opts, queue, name, cmd + args, expected)
 
 
+def binary_test(opts, queue, name, args=[]):
+    """Runs the replay that `name` names, minus "-binary", with --binary.
+
+    The snapshots decoded from its command log must match the text goldens exactly.
+    """
+    replay = name[:-len("-binary")]
+    with NamedTemporaryDir() as d:
+        cmd = ["out/cur/replay", "test/%s.NLRP" % replay, "--text", "--binary", "--output=%s" % d]
+        if not run(opts, queue, name, cmd + args):
+            return False
+        log = os.path.join(d, "commands.bin")
+        if not run(opts, queue, name, ["out/cur/decode-command-log", "--output=%s" % d, log]):
+            return False
+        os.remove(log)
+        return run(opts, queue, name,
+                   ["diff", "--strip-trailing-cr", "-ru", "-x.*", "test/%s" % replay, d])
+
+
 def call(args):
     fn = args[0]
     opts = args[1]
@@ -112,7 +271,7 @@ def call(args):
 
 def main():
     if sys.platform.startswith("linux"):
-        if "DISPLAY" not in os.environ:
+        if ("DISPLAY" not in os.environ) and ("--software" not in sys.argv):
             # TODO(sfiera): determine when Xvfb is unnecessary and skip this.
             print("no DISPLAY; using Xvfb")
             os.execvp("xvfb-run", ["xvfb-run", "-s", "-screen 0 640x480x24"] + sys.argv)
@@ -128,22 +287,35 @@ def main():
     parser = argparse.ArgumentParser()
     parser.add_argument("--smoke", action="store_true")
     parser.add_argument("--wine", action="store_true")
+    parser.add_argument("--software", action="store_true", help="render without OpenGL")
+    parser.add_argument(
+        "--hash", action="store_true", help="compare digests of snapshots; diff only mismatches")
     parser.add_argument("-t", "--type", action="append", choices=test_types)
     parser.add_argument("test", nargs="*")
     opts = parser.parse_args()
 
+    software_args = ["--software"] if opts.software else []
+
     queue = multiprocessing.Queue()
     pool = multiprocessing.pool.ThreadPool()
     tests = [
+        (unit_test, opts, queue, "asset-cache-test"),
+        (unit_test, opts, queue, "card-test"),
         (unit_test, opts, queue, "color-test"),
+        (unit_test, opts, queue, "command-log-test"),
+        (unit_test, opts, queue, "compiled-scenario-test"),
         (unit_test, opts, queue, "editable-text-test"),
         (unit_test, opts, queue, "fixed-test"),
-        (data_test, opts, queue, "build-pix", [], ["--text"]),
+        (unit_test, opts, queue, "pix-kernels-test"),
+        (unit_test, opts, queue, "sprite-handling-test"),
+        (unit_test, opts, queue, "styled-text-test"),
+        (data_test, opts, queue, "build-pix", software_args, ["--text"]),
         (data_test, opts, queue, "object-data"),
         (data_test, opts, queue, "shapes"),
         (data_test, opts, queue, "tint"),
         (offscreen_test, opts, queue, "fast-motion", ["--text"]),
         (offscreen_test, opts, queue, "main-screen"),
+        (software_test, opts, queue, "main-screen-software"),
         (offscreen_test, opts, queue, "mission-briefing", ["--text"]),
         (offscreen_test, opts, queue, "options"),
         (offscreen_test, opts, queue, "pause", ["--text"]),
@@ -157,6 +329,7 @@ def main():
         (replay_test, opts, queue, "out-of-the-frying-pan"),
         (replay_test, opts, queue, "shoplifter-1"),
         (replay_test, opts, queue, "space-race"),
+        (binary_test, opts, queue, "space-race-binary"),
         (replay_test, opts, queue, "the-left-hand"),
         (replay_test, opts, queue, "the-mothership-connection"),
         (replay_test, opts, queue, "the-stars-have-ears"),
@@ -175,9 +348,13 @@ def main():
         if "data" not in opts.type:
             tests = [t for t in tests if t[0] != data_test]
         if "offscreen" not in opts.type:
-            tests = [t for t in tests if t[0] != offscreen_test]
+            tests = [t for t in tests if t[0] not in (offscreen_test, software_test)]
         if "replay" not in opts.type:
-            tests = [t for t in tests if t[0] != replay_test]
+            tests = [t for t in tests if t[0] not in (replay_test, binary_test)]
+
+    if opts.smoke:
+        # Smoke runs don't write snapshots, so there is no command log to decode.
+        tests = [t for t in tests if t[0] != binary_test]
 
     if opts.wine:
         tests = [t for t in tests if t[3] in WINE_TESTS]
@@ -34,6 +34,7 @@
 #include "drawing/text.hpp"
 #include "lang/exception.hpp"
 #include "video/offscreen-driver.hpp"
+#include "video/software-driver.hpp"
 #include "video/text-driver.hpp"
 
 using sfz::dec;
@@ -74,20 +75,23 @@ void usage(pn::output_view out, pn::string_view progname, int retcode) {
             "  options:\n"
             "    -o, --output=OUTPUT place output in this directory\n"
             "    -h, --help          display this help screen\n"
-            "    -t, --text          produce text output\n",
+            "    -t, --text          produce text output\n"
+            "        --software      render without OpenGL\n"
+            "        --hash          write a digest of each image instead of the image\n"
+            "        --binary        with --text, write one binary log for decode-command-log\n",
             progname);
     exit(retcode);
 }
 
 std::function<pn::string_view()> prologue(pn::string_view chapter) {
     return [chapter]() -> pn::string_view {
-        return *plug.levels.find(chapter.copy())->second.solo.prologue;
+        return *Level::get(chapter)->solo.prologue;
     };
 }
 
 std::function<pn::string_view()> epilogue(pn::string_view chapter) {
     return [chapter]() -> pn::string_view {
-        return *plug.levels.find(chapter.copy())->second.solo.epilogue;
+        return *Level::get(chapter)->solo.epilogue;
     };
 }
 
@@ -129,8 +133,11 @@ void main(int argc, char* const* argv) {
     callbacks.argument = [](pn::string_view arg) { return false; };
 
     sfz::optional<pn::string> output_dir;
-    bool                      text = false;
-    callbacks.short_option         = [&argv, &output_dir, &text](
+    bool                      text     = false;
+    bool                      software = false;
+    bool                      hash     = false;
+    bool                      binary   = false;
+    callbacks.short_option             = [&argv, &output_dir, &text](
                                      pn::rune opt, const args::callbacks::get_value_f& get_value) {
         switch (opt.value()) {
             case 'o': output_dir.emplace(get_value().copy()); return true;
@@ -139,18 +146,28 @@ void main(int argc, char* const* argv) {
             default: return false;
         }
     };
-    callbacks.long_option =
-            [&callbacks](pn::string_view opt, const args::callbacks::get_value_f& get_value) {
-                if (opt == "output") {
-                    return callbacks.short_option(pn::rune{'o'}, get_value);
-                } else if (opt == "text") {
-                    return callbacks.short_option(pn::rune{'t'}, get_value);
-                } else if (opt == "help") {
-                    return callbacks.short_option(pn::rune{'h'}, get_value);
-                } else {
-                    return false;
-                }
-            };
+    callbacks.long_option = [&callbacks, &software, &hash, &binary](
+                                    pn::string_view                     opt,
+                                    const args::callbacks::get_value_f& get_value) {
+        if (opt == "output") {
+            return callbacks.short_option(pn::rune{'o'}, get_value);
+        } else if (opt == "text") {
+            return callbacks.short_option(pn::rune{'t'}, get_value);
+        } else if (opt == "software") {
+            software = true;
+            return true;
+        } else if (opt == "hash") {
+            hash = true;
+            return true;
+        } else if (opt == "binary") {
+            binary = true;
+            return true;
+        } else if (opt == "help") {
+            return callbacks.short_option(pn::rune{'h'}, get_value);
+        } else {
+            return false;
+        }
+    };
 
     args::parse(argc - 1, argv + 1, callbacks);
 
@@ -161,9 +178,15 @@ void main(int argc, char* const* argv) {
     NullPrefsDriver prefs;
     if (text) {
         TextVideoDriver video({540, 2000}, output_dir);
+        video.set_hash_only(hash);
+        video.set_binary_log(binary);
         run(&video, "txt", [](Rect) {});
+    } else if (software) {
+        SoftwareVideoDriver video({540, 2000}, output_dir);
+        run(&video, "png", [&video](Rect r) { video.set_capture_rect(r); });
     } else {
         OffscreenVideoDriver video({540, 2000}, output_dir);
+        video.set_hash_only(hash);
         run(&video, "png", [&video](Rect r) { video.set_capture_rect(r); });
     }
 }
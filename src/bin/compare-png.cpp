@@ -0,0 +1,138 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <stdlib.h>
+#include <algorithm>
+#include <pn/input>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+
+#include "drawing/pix-map.hpp"
+#include "lang/exception.hpp"
+
+using sfz::range;
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS] expected actual\n"
+            "\n"
+            "  Compares two PNG images pixel by pixel\n"
+            "\n"
+            "  arguments:\n"
+            "    expected            the image to compare against\n"
+            "    actual              the image to compare\n"
+            "\n"
+            "  options:\n"
+            "    -t, --tolerance=N   let each channel differ by up to N (default: 0)\n"
+            "    -h, --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+ArrayPixMap read(pn::string_view path) {
+    pn::input in{path, pn::binary};
+    if (!in) {
+        throw std::runtime_error(pn::format("{0}: couldn't open", path).c_str());
+    }
+    return read_png(in);
+}
+
+int difference(RgbColor x, RgbColor y) {
+    return std::max({abs(x.red - y.red), abs(x.green - y.green), abs(x.blue - y.blue),
+                     abs(x.alpha - y.alpha)});
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    sfz::optional<pn::string> expected_path;
+    sfz::optional<pn::string> actual_path;
+    callbacks.argument = [&expected_path, &actual_path](pn::string_view arg) {
+        if (!expected_path.has_value()) {
+            expected_path.emplace(arg.copy());
+        } else if (!actual_path.has_value()) {
+            actual_path.emplace(arg.copy());
+        } else {
+            return false;
+        }
+        return true;
+    };
+
+    int tolerance          = 0;
+    callbacks.short_option = [&argv, &tolerance](
+                                     pn::rune opt, const args::callbacks::get_value_f& get_value) {
+        switch (opt.value()) {
+            case 't': sfz::args::integer_option(get_value(), &tolerance); return true;
+            case 'h': usage(pn::out, sfz::path::basename(argv[0]), 0); return true;
+            default: return false;
+        }
+    };
+
+    callbacks.long_option =
+            [&callbacks](pn::string_view opt, const args::callbacks::get_value_f& get_value) {
+                if (opt == "tolerance") {
+                    return callbacks.short_option(pn::rune{'t'}, get_value);
+                } else if (opt == "help") {
+                    return callbacks.short_option(pn::rune{'h'}, get_value);
+                } else {
+                    return false;
+                }
+            };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (!expected_path.has_value()) {
+        throw std::runtime_error("missing required argument 'expected'");
+    } else if (!actual_path.has_value()) {
+        throw std::runtime_error("missing required argument 'actual'");
+    }
+
+    ArrayPixMap expected = read(*expected_path);
+    ArrayPixMap actual   = read(*actual_path);
+    Size        size     = expected.size();
+    Size        other    = actual.size();
+    if (size != other) {
+        throw std::runtime_error(
+                pn::format(
+                        "{0}: size {1}x{2} != {3}x{4}", *actual_path, size.width, size.height,
+                        other.width, other.height)
+                        .c_str());
+    }
+
+    int worst = 0;
+    for (int32_t y : range(size.height)) {
+        const RgbColor* expected_row = expected.row(y);
+        const RgbColor* actual_row   = actual.row(y);
+        for (int32_t x : range(size.width)) {
+            worst = std::max(worst, difference(expected_row[x], actual_row[x]));
+        }
+    }
+    if (worst > tolerance) {
+        throw std::runtime_error(
+                pn::format("{0}: channels differ by up to {1}", *actual_path, worst).c_str());
+    }
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
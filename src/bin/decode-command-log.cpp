@@ -0,0 +1,98 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <pn/output>
+#include <sfz/sfz.hpp>
+
+#include "lang/exception.hpp"
+#include "video/command-log.hpp"
+
+namespace args = sfz::args;
+namespace path = sfz::path;
+
+namespace antares {
+namespace {
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS] log\n"
+            "\n"
+            "  Turns a binary command log back into text snapshots\n"
+            "\n"
+            "  arguments:\n"
+            "    log                 a commands.bin written by --text --binary\n"
+            "\n"
+            "  options:\n"
+            "    -o, --output=OUTPUT place output in this directory (default: .)\n"
+            "    -h, --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    sfz::optional<pn::string> log_path;
+    callbacks.argument = [&log_path](pn::string_view arg) {
+        if (!log_path.has_value()) {
+            log_path.emplace(arg.copy());
+        } else {
+            return false;
+        }
+        return true;
+    };
+
+    pn::string output_dir = ".";
+    callbacks.short_option =
+            [&argv, &output_dir](pn::rune opt, const args::callbacks::get_value_f& get_value) {
+                switch (opt.value()) {
+                    case 'o': output_dir = get_value().copy(); return true;
+                    case 'h': usage(pn::out, sfz::path::basename(argv[0]), 0); return true;
+                    default: return false;
+                }
+            };
+
+    callbacks.long_option =
+            [&callbacks](pn::string_view opt, const args::callbacks::get_value_f& get_value) {
+                if (opt == "output") {
+                    return callbacks.short_option(pn::rune{'o'}, get_value);
+                } else if (opt == "help") {
+                    return callbacks.short_option(pn::rune{'h'}, get_value);
+                } else {
+                    return false;
+                }
+            };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (!log_path.has_value()) {
+        throw std::runtime_error("missing required argument 'log'");
+    }
+
+    sfz::mapped_file file(*log_path);
+    decode_command_log(file.data(), [&output_dir](pn::string_view relpath, pn::string_view text) {
+        pn::string path = pn::format("{0}/{1}", output_dir, relpath);
+        sfz::makedirs(path::dirname(path), 0755);
+        pn::output out{path, pn::binary};
+        out.write(text);
+    });
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
@@ -0,0 +1,89 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <pn/input>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+#include <vector>
+
+#include "drawing/pix-map.hpp"
+#include "lang/exception.hpp"
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+void usage(pn::output_view out, pn::string_view progname, int retcode) {
+    out.format(
+            "usage: {0} [OPTIONS] image...\n"
+            "\n"
+            "  Prints the digest of the pixels of each PNG image, as --hash writes them\n"
+            "\n"
+            "  arguments:\n"
+            "    image               a PNG image to take the digest of\n"
+            "\n"
+            "  options:\n"
+            "    -h, --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    std::vector<pn::string> images;
+    callbacks.argument = [&images](pn::string_view arg) {
+        images.push_back(arg.copy());
+        return true;
+    };
+
+    callbacks.short_option = [&argv](pn::rune opt, const args::callbacks::get_value_f& get_value) {
+        switch (opt.value()) {
+            case 'h': usage(pn::out, sfz::path::basename(argv[0]), 0); return true;
+            default: return false;
+        }
+    };
+
+    callbacks.long_option =
+            [&callbacks](pn::string_view opt, const args::callbacks::get_value_f& get_value) {
+                if (opt == "help") {
+                    return callbacks.short_option(pn::rune{'h'}, get_value);
+                } else {
+                    return false;
+                }
+            };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (images.empty()) {
+        throw std::runtime_error("missing required argument 'image'");
+    }
+
+    for (const pn::string& path : images) {
+        pn::input in{path, pn::binary};
+        if (!in) {
+            throw std::runtime_error(pn::format("{0}: couldn't open", path).c_str());
+        }
+        pn::out.format("{0}\t{1}\n", path, read_png(in).digest().hex());
+    }
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) { return antares::wrap_main(antares::main, argc, argv); }
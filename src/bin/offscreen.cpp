@@ -32,6 +32,7 @@
 #include "ui/flows/master.hpp"
 #include "video/driver.hpp"
 #include "video/offscreen-driver.hpp"
+#include "video/software-driver.hpp"
 #include "video/text-driver.hpp"
 
 using sfz::makedirs;
@@ -64,6 +65,10 @@ void usage(pn::output_view out, pn::string_view progname, int retcode) {
             "options:\n"
             " -o, --output=OUTPUT place output in this directory\n"
             " -t, --text          produce text output\n"
+            "     --software      render without OpenGL\n"
+            "     --hash          write a digest of each screenshot instead of the screenshot\n"
+            "                     (not with --software)\n"
+            "     --binary        with --text, write one binary log for decode-command-log\n"
             " -h, --help          display this help screen\n",
             progname);
     exit(retcode);
@@ -83,8 +88,11 @@ void main(int argc, char* const* argv) {
     };
 
     sfz::optional<pn::string> output_dir;
-    bool                      text = false;
-    callbacks.short_option         = [&argv, &output_dir, &text](
+    bool                      text     = false;
+    bool                      software = false;
+    bool                      hash     = false;
+    bool                      binary   = false;
+    callbacks.short_option             = [&argv, &output_dir, &text](
                                      pn::rune opt, const args::callbacks::get_value_f& get_value) {
         switch (opt.value()) {
             case 'o': output_dir.emplace(get_value().copy()); return true;
@@ -94,20 +102,33 @@ void main(int argc, char* const* argv) {
         }
     };
 
-    callbacks.long_option =
-            [&callbacks](pn::string_view opt, const args::callbacks::get_value_f& get_value) {
-                if (opt == "output") {
-                    return callbacks.short_option(pn::rune{'o'}, get_value);
-                } else if (opt == "text") {
-                    return callbacks.short_option(pn::rune{'t'}, get_value);
-                } else if (opt == "help") {
-                    return callbacks.short_option(pn::rune{'h'}, get_value);
-                } else {
-                    return false;
-                }
-            };
+    callbacks.long_option = [&callbacks, &software, &hash, &binary](
+                                    pn::string_view                     opt,
+                                    const args::callbacks::get_value_f& get_value) {
+        if (opt == "output") {
+            return callbacks.short_option(pn::rune{'o'}, get_value);
+        } else if (opt == "text") {
+            return callbacks.short_option(pn::rune{'t'}, get_value);
+        } else if (opt == "software") {
+            software = true;
+            return true;
+        } else if (opt == "hash") {
+            hash = true;
+            return true;
+        } else if (opt == "binary") {
+            binary = true;
+            return true;
+        } else if (opt == "help") {
+            return callbacks.short_option(pn::rune{'h'}, get_value);
+        } else {
+            return false;
+        }
+    };
 
     args::parse(argc - 1, argv + 1, callbacks);
+    if (software && hash && !text) {
+        throw std::runtime_error("--hash can't be used with --software");
+    }
 
     if (output_dir.has_value()) {
         makedirs(*output_dir, 0755);
@@ -143,9 +164,15 @@ void main(int argc, char* const* argv) {
 
     if (text) {
         TextVideoDriver video({640, 480}, output_dir);
+        video.set_hash_only(hash);
+        video.set_binary_log(binary);
+        video.loop(new Master(sfz::nullopt, 14586), scheduler);
+    } else if (software) {
+        SoftwareVideoDriver video({640, 480}, output_dir);
         video.loop(new Master(sfz::nullopt, 14586), scheduler);
     } else {
         OffscreenVideoDriver video({640, 480}, output_dir);
+        video.set_hash_only(hash);
         video.loop(new Master(sfz::nullopt, 14586), scheduler);
     }
 }
@@ -55,6 +55,7 @@
 #include "ui/screens/debriefing.hpp"
 #include "video/driver.hpp"
 #include "video/offscreen-driver.hpp"
+#include "video/software-driver.hpp"
 #include "video/text-driver.hpp"
 
 using std::unique_ptr;
@@ -160,10 +161,16 @@ void usage(pn::output_view out, pn::string_view progname, int retcode) {
             "    -o, --output=OUTPUT place output in this directory\n"
             "    -i, --interval=INTERVAL\n"
             "                        take one screenshot per this many ticks (default: 60)\n"
+            "    -v, --video=VIDEO   write screenshots to this file or pipe as raw BGRA video\n"
+            "                        (not with --text, --smoke, or --software)\n"
             "    -w, --width=WIDTH   screen width (default: 640)\n"
             "    -h, --height=HEIGHT screen height (default: 480)\n"
             "    -t, --text          produce text output\n"
+            "        --hash          write a digest of each screenshot instead of the screenshot\n"
+            "                        (not with --software)\n"
+            "        --binary        with --text, write one binary log for decode-command-log\n"
             "    -s, --smoke         run as smoke text\n"
+            "        --software      render without OpenGL\n"
             "        --help          display this help screen\n",
             progname);
     exit(retcode);
@@ -183,16 +190,22 @@ void main(int argc, char* const* argv) {
     };
 
     sfz::optional<pn::string> output_dir;
+    sfz::optional<pn::string> video_path;
     int                       interval = 60;
     int                       width    = 640;
     int                       height   = 480;
     bool                      text     = false;
     bool                      smoke    = false;
-    callbacks.short_option             = [&output_dir, &interval, &width, &height, &text, &smoke](
+    bool                      software = false;
+    bool                      hash     = false;
+    bool                      binary   = false;
+    callbacks.short_option             = [&output_dir, &video_path, &interval, &width, &height,
+                                      &text, &smoke](
                                      pn::rune opt, const args::callbacks::get_value_f& get_value) {
         switch (opt.value()) {
             case 'o': output_dir.emplace(get_value().copy()); return true;
             case 'i': sfz::args::integer_option(get_value(), &interval); return true;
+            case 'v': video_path.emplace(get_value().copy()); return true;
             case 'w': sfz::args::integer_option(get_value(), &width); return true;
             case 'h': sfz::args::integer_option(get_value(), &height); return true;
             case 't': text = true; return true;
@@ -201,13 +214,15 @@ void main(int argc, char* const* argv) {
         }
     };
 
-    callbacks.long_option = [&argv, &callbacks](
+    callbacks.long_option = [&argv, &callbacks, &software, &hash, &binary](
                                     pn::string_view                     opt,
                                     const args::callbacks::get_value_f& get_value) {
         if (opt == "output") {
             return callbacks.short_option(pn::rune{'o'}, get_value);
         } else if (opt == "interval") {
             return callbacks.short_option(pn::rune{'i'}, get_value);
+        } else if (opt == "video") {
+            return callbacks.short_option(pn::rune{'v'}, get_value);
         } else if (opt == "width") {
             return callbacks.short_option(pn::rune{'w'}, get_value);
         } else if (opt == "height") {
@@ -216,6 +231,15 @@ void main(int argc, char* const* argv) {
             return callbacks.short_option(pn::rune{'t'}, get_value);
         } else if (opt == "smoke") {
             return callbacks.short_option(pn::rune{'s'}, get_value);
+        } else if (opt == "software") {
+            software = true;
+            return true;
+        } else if (opt == "hash") {
+            hash = true;
+            return true;
+        } else if (opt == "binary") {
+            binary = true;
+            return true;
         } else if (opt == "help") {
             usage(pn::out, sfz::path::basename(argv[0]), 0);
             return true;
@@ -228,6 +252,11 @@ void main(int argc, char* const* argv) {
     if (!replay_path.has_value()) {
         throw std::runtime_error("missing required argument 'replay'");
     }
+    if (video_path.has_value() && (text || smoke || software)) {
+        throw std::runtime_error("--video can't be used with --text, --smoke, or --software");
+    } else if (software && hash && !(text || smoke)) {
+        throw std::runtime_error("--hash can't be used with --software");
+    }
 
     if (output_dir.has_value()) {
         sfz::makedirs(*output_dir, 0755);
@@ -259,9 +288,18 @@ void main(int argc, char* const* argv) {
         video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
     } else if (text) {
         TextVideoDriver video({width, height}, output_dir);
+        video.set_hash_only(hash);
+        video.set_binary_log(binary);
+        video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
+    } else if (software) {
+        SoftwareVideoDriver video({width, height}, output_dir);
         video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
     } else {
         OffscreenVideoDriver video({width, height}, output_dir);
+        if (video_path.has_value()) {
+            video.set_video_output(*video_path);
+        }
+        video.set_hash_only(hash);
         video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
     }
 }
@@ -108,6 +108,9 @@ FilePrefsDriver::FilePrefsDriver(pn::string_view path) : _path(path.copy()) {
     pn::map_cref video = m.get("video").as_map();
     set(_current.fullscreen, video.get("fullscreen"));
     set(_current.window_size, video.get("window"));
+    set(_current.discard_pixels, video.get("discard pixels"));
+    set(_current.swap_interval, video.get("swap interval"));
+    set(_current.frame_cap, video.get("frame cap"));
 }
 
 void FilePrefsDriver::set(const Preferences& p) {
@@ -137,6 +140,9 @@ void FilePrefsDriver::set(const Preferences& p) {
                               {"width", p.window_size.width},
                               {"height", p.window_size.height},
                       }},
+                     {"discard pixels", p.discard_pixels},
+                     {"swap interval", p.swap_interval},
+                     {"frame cap", p.frame_cap},
              }},
     });
 }
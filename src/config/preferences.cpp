@@ -100,6 +100,10 @@ Preferences::Preferences() {
 
     fullscreen  = false;
     window_size = {640, 480};
+
+    discard_pixels = false;
+    swap_interval  = 1;
+    frame_cap      = 0;
 }
 
 Preferences Preferences::copy() const {
@@ -111,6 +115,9 @@ Preferences Preferences::copy() const {
     copy.volume             = volume;
     copy.fullscreen         = fullscreen;
     copy.window_size        = window_size;
+    copy.discard_pixels     = discard_pixels;
+    copy.swap_interval      = swap_interval;
+    copy.frame_cap          = frame_cap;
     return copy;
 }
 
@@ -165,6 +172,24 @@ void PrefsDriver::set_window_size(Size size) {
     set(p);
 }
 
+void PrefsDriver::set_discard_pixels(bool on) {
+    Preferences p(get().copy());
+    p.discard_pixels = on;
+    set(p);
+}
+
+void PrefsDriver::set_swap_interval(int interval) {
+    Preferences p(get().copy());
+    p.swap_interval = interval;
+    set(p);
+}
+
+void PrefsDriver::set_frame_cap(int fps) {
+    Preferences p(get().copy());
+    p.frame_cap = fps;
+    set(p);
+}
+
 NullPrefsDriver::NullPrefsDriver() {}
 
 NullPrefsDriver::NullPrefsDriver(Preferences defaults) : _saved(defaults.copy()) {}
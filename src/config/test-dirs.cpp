@@ -27,6 +27,7 @@ namespace antares {
 #define STRINGIFY_(x) #x
 #define STRINGIFY(x) STRINGIFY_(x)
 #define ANTARES_DATA_STRING STRINGIFY(ANTARES_DATA)
+#define ANTARES_CACHE_STRING STRINGIFY(ANTARES_CACHE)
 
 pn::string_view default_application_path() { return ANTARES_DATA_STRING; }
 
@@ -38,6 +39,7 @@ pn::string_view default_factory_scenario_path() {
 Directories test_dirs() {
     Directories directories;
     directories.root      = application_path().copy();
+    directories.cache     = ANTARES_CACHE_STRING;  // In the build directory, not the source tree.
     directories.downloads = pn::format("{0}/downloads", directories.root);
     directories.registry  = pn::format("{0}/registry", directories.root);
     directories.replays   = pn::format("{0}/replays", directories.root);
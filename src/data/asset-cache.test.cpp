@@ -0,0 +1,88 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "data/asset-cache.hpp"
+
+#include <gmock/gmock.h>
+#include <memory>
+
+using testing::Eq;
+
+namespace antares {
+namespace {
+
+using AssetCacheTest = testing::Test;
+
+TEST_F(AssetCacheTest, TakeRemoves) {
+    AssetCache<int, std::unique_ptr<int>> cache(10);
+    cache.put(1, std::unique_ptr<int>(new int(100)), 3);
+    EXPECT_THAT(cache.size(), Eq(1u));
+    EXPECT_THAT(cache.cost(), Eq(3u));
+
+    auto value = cache.take(1);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_THAT(**value, Eq(100));
+    EXPECT_THAT(cache.size(), Eq(0u));
+    EXPECT_THAT(cache.cost(), Eq(0u));
+
+    EXPECT_FALSE(cache.take(1).has_value());
+    EXPECT_FALSE(cache.take(2).has_value());
+    EXPECT_THAT(cache.stats().hits, Eq(1));
+    EXPECT_THAT(cache.stats().misses, Eq(2));
+}
+
+TEST_F(AssetCacheTest, EvictsOldest) {
+    AssetCache<int, int> cache(10);
+    cache.put(1, 10, 4);
+    cache.put(2, 20, 4);
+    cache.put(3, 30, 4);  // Over budget: evicts 1.
+    EXPECT_THAT(cache.size(), Eq(2u));
+    EXPECT_THAT(cache.cost(), Eq(8u));
+    EXPECT_THAT(cache.stats().evictions, Eq(1));
+    EXPECT_FALSE(cache.take(1).has_value());
+
+    // Storing 2 again makes it the newest, so 3 goes next.
+    cache.put(2, 21, 4);
+    cache.put(4, 40, 4);
+    EXPECT_FALSE(cache.take(3).has_value());
+    EXPECT_THAT(*cache.take(2), Eq(21));
+    EXPECT_THAT(*cache.take(4), Eq(40));
+    EXPECT_THAT(cache.stats().evictions, Eq(2));
+}
+
+TEST_F(AssetCacheTest, OverBudget) {
+    AssetCache<int, int> cache(10);
+    cache.put(1, 10, 4);
+    cache.put(2, 20, 11);
+    EXPECT_FALSE(cache.take(2).has_value());
+    EXPECT_THAT(*cache.take(1), Eq(10));
+    EXPECT_THAT(cache.stats().evictions, Eq(1));
+}
+
+TEST_F(AssetCacheTest, Clear) {
+    AssetCache<int, int> cache(10);
+    cache.put(1, 10, 4);
+    cache.put(2, 20, 4);
+    cache.clear();
+    EXPECT_THAT(cache.size(), Eq(0u));
+    EXPECT_THAT(cache.cost(), Eq(0u));
+    EXPECT_FALSE(cache.take(1).has_value());
+}
+
+}  // namespace
+}  // namespace antares
@@ -0,0 +1,314 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include "data/compiled-scenario.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pn/array>
+#include <pn/map>
+#include <pn/output>
+#include <stdexcept>
+
+namespace path = sfz::path;
+
+namespace antares {
+
+const char kCompiledScenarioMagic[4] = {'A', 'C', 'S', '1'};
+
+namespace {
+
+class ValueWriter {
+  public:
+    ValueWriter(std::vector<uint8_t>* out) : _out(out) {}
+
+    void byte(uint8_t b) { _out->push_back(b); }
+
+    void number(uint64_t n) {
+        while (n >= 0x80) {
+            byte(0x80 | (n & 0x7f));
+            n >>= 7;
+        }
+        byte(n);
+    }
+
+    void bytes(const uint8_t* data, size_t size) { _out->insert(_out->end(), data, data + size); }
+
+    void string(pn::string_view s) {
+        number(s.size());
+        bytes(reinterpret_cast<const uint8_t*>(s.data()), s.size());
+    }
+
+    void value(pn::value_cref x) {
+        switch (x.type()) {
+            case PN_NULL: byte('n'); break;
+            case PN_BOOL: byte(x.as_bool() ? 't' : 'f'); break;
+
+            case PN_INT: {
+                int64_t i = x.as_int();
+                byte('i');
+                number((uint64_t(i) << 1) ^ uint64_t(i >> 63));
+                break;
+            }
+
+            case PN_FLOAT: {
+                double   f = x.as_float();
+                uint64_t bits;
+                memcpy(&bits, &f, sizeof(bits));
+                byte('d');
+                for (int i = 0; i < 8; ++i) {
+                    byte(bits >> (8 * i));
+                }
+                break;
+            }
+
+            case PN_DATA:
+                byte('x');
+                number(x.as_data().size());
+                bytes(x.as_data().data(), x.as_data().size());
+                break;
+
+            case PN_STRING:
+                byte('s');
+                string(x.as_string());
+                break;
+
+            case PN_ARRAY:
+                byte('a');
+                number(x.as_array().size());
+                for (pn::value_cref y : x.as_array()) {
+                    value(y);
+                }
+                break;
+
+            case PN_MAP:
+                byte('m');
+                number(x.as_map().size());
+                for (pn::key_value_cref kv : x.as_map()) {
+                    string(kv.key());
+                    value(kv.value());
+                }
+                break;
+        }
+    }
+
+  private:
+    std::vector<uint8_t>* const _out;
+};
+
+class ValueReader {
+  public:
+    ValueReader(pn::data_view in) : _data(in.data()), _end(in.data() + in.size()) {}
+
+    bool done() const { return _data == _end; }
+
+    uint8_t byte() {
+        if (_data == _end) {
+            throw std::runtime_error("compiled scenario: unexpected end");
+        }
+        return *(_data++);
+    }
+
+    uint64_t number() {
+        uint64_t n = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = byte();
+            n |= uint64_t(b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                return n;
+            }
+        }
+        throw std::runtime_error("compiled scenario: bad number");
+    }
+
+    pn::data_view bytes(uint64_t size) {
+        if (size > uint64_t(_end - _data)) {
+            throw std::runtime_error("compiled scenario: unexpected end");
+        }
+        pn::data_view d(_data, static_cast<int>(size));
+        _data += size;
+        return d;
+    }
+
+    pn::string_view string() {
+        pn::data_view d = bytes(number());
+        return pn::string_view(reinterpret_cast<const char*>(d.data()), d.size());
+    }
+
+    pn::value value() {
+        switch (byte()) {
+            case 'n': return nullptr;
+            case 't': return true;
+            case 'f': return false;
+
+            case 'i': {
+                uint64_t n = number();
+                return int64_t(n >> 1) ^ -int64_t(n & 1);
+            }
+
+            case 'd': {
+                uint64_t bits = 0;
+                for (int i = 0; i < 8; ++i) {
+                    bits |= uint64_t(byte()) << (8 * i);
+                }
+                double f;
+                memcpy(&f, &bits, sizeof(f));
+                return f;
+            }
+
+            case 'x': return bytes(number()).copy();
+            case 's': return string().copy();
+
+            case 'a': {
+                pn::array a;
+                for (uint64_t n = number(); n > 0; --n) {
+                    a.push_back(value());
+                }
+                return std::move(a);
+            }
+
+            case 'm': {
+                pn::map m;
+                for (uint64_t n = number(); n > 0; --n) {
+                    pn::string_view k = string();
+                    m.set(k, value());
+                }
+                return std::move(m);
+            }
+
+            default: throw std::runtime_error("compiled scenario: bad value");
+        }
+    }
+
+  private:
+    const uint8_t* _data;
+    const uint8_t* _end;
+};
+
+}  // namespace
+
+void encode_value(pn::value_cref x, std::vector<uint8_t>* out) { ValueWriter(out).value(x); }
+
+pn::value decode_value(pn::data_view in) {
+    ValueReader r(in);
+    pn::value   x = r.value();
+    if (!r.done()) {
+        throw std::runtime_error("compiled scenario: trailing data");
+    }
+    return x;
+}
+
+CompiledScenario::CompiledScenario(pn::string_view path) : _file(path) {}
+
+std::unique_ptr<CompiledScenario> CompiledScenario::open(
+        pn::string_view path, const sfz::sha1::digest& digest) {
+    if (!path::isfile(path)) {
+        return nullptr;
+    }
+    try {
+        std::unique_ptr<CompiledScenario> compiled(new CompiledScenario(path));
+        ValueReader                       r(compiled->_file.data());
+        for (char c : kCompiledScenarioMagic) {
+            if (r.byte() != uint8_t(c)) {
+                return nullptr;
+            }
+        }
+        for (uint32_t word : digest.digest32) {
+            uint32_t stored = 0;
+            for (int i = 0; i < 4; ++i) {
+                stored = (stored << 8) | r.byte();
+            }
+            if (stored != word) {
+                return nullptr;
+            }
+        }
+        for (uint64_t n = r.number(); n > 0; --n) {
+            pn::string resource_path = r.string().copy();
+            compiled->_index.emplace(std::move(resource_path), r.bytes(r.number()));
+        }
+        if (!r.done()) {
+            return nullptr;
+        }
+        return compiled;
+    } catch (std::runtime_error&) {
+        return nullptr;
+    }
+}
+
+void CompiledScenario::write(
+        pn::string_view path, const sfz::sha1::digest& digest,
+        const std::map<pn::string, pn::value>& values) {
+    std::vector<uint8_t> buffer;
+    ValueWriter          w(&buffer);
+    w.bytes(reinterpret_cast<const uint8_t*>(kCompiledScenarioMagic),
+            sizeof(kCompiledScenarioMagic));
+    for (uint32_t word : digest.digest32) {
+        for (int i = 3; i >= 0; --i) {
+            w.byte(word >> (8 * i));
+        }
+    }
+    w.number(values.size());
+    std::vector<uint8_t> value;
+    for (const auto& kv : values) {
+        value.clear();
+        encode_value(kv.second, &value);
+        w.string(kv.first);
+        w.number(value.size());
+        w.bytes(value.data(), value.size());
+    }
+
+    // Written under a unique name, then moved into place, so that a reader never maps a
+    // partially-written image, and processes writing at once don't write into the same file.
+    sfz::makedirs(path::dirname(path), 0755);
+    pn::string tmp = pn::format("{0}.XXXXXX", path);
+    int        fd  = mkstemp(tmp.data());
+    if (fd < 0) {
+        throw std::runtime_error(pn::format("{0}: couldn't create", tmp).c_str());
+    }
+    bool written;
+    {
+        pn::output out{fdopen(fd, "wb")};
+        if (!out) {
+            close(fd);
+        }
+        written = out &&
+                  out.write(pn::data_view{buffer.data(), static_cast<int>(buffer.size())}) &&
+                  out.flush();
+    }
+    if (!written) {
+        unlink(tmp.c_str());
+        throw std::runtime_error(pn::format("{0}: couldn't write", tmp).c_str());
+    }
+    if (rename(tmp.c_str(), path.copy().c_str()) != 0) {
+        unlink(tmp.c_str());
+        throw std::runtime_error(pn::format("{0}: couldn't rename", tmp).c_str());
+    }
+}
+
+sfz::optional<pn::value> CompiledScenario::get(pn::string_view resource_path) const {
+    auto it = _index.find(resource_path.copy());
+    if (it == _index.end()) {
+        return sfz::nullopt;
+    }
+    return sfz::optional<pn::value>{decode_value(it->second)};
+}
+
+}  // namespace antares
@@ -0,0 +1,133 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "data/compiled-scenario.hpp"
+
+#include <gmock/gmock.h>
+#include <pn/array>
+#include <pn/map>
+#include <pn/output>
+#include <stdexcept>
+
+#include "config/dirs.hpp"
+
+using testing::Eq;
+using testing::IsNull;
+using testing::NotNull;
+
+namespace antares {
+namespace {
+
+using CompiledScenarioTest = testing::Test;
+
+pn::value round_trip(const pn::value& x) {
+    std::vector<uint8_t> encoded;
+    encode_value(x, &encoded);
+    return decode_value(pn::data_view{encoded.data(), static_cast<int>(encoded.size())});
+}
+
+TEST_F(CompiledScenarioTest, Scalars) {
+    EXPECT_TRUE(round_trip(nullptr).is_null());
+    EXPECT_THAT(round_trip(true).as_bool(), Eq(true));
+    EXPECT_THAT(round_trip(false).as_bool(), Eq(false));
+    EXPECT_THAT(round_trip(0).as_int(), Eq(0));
+    EXPECT_THAT(round_trip(-1).as_int(), Eq(-1));
+    EXPECT_THAT(round_trip(int64_t(INT64_MAX)).as_int(), Eq(INT64_MAX));
+    EXPECT_THAT(round_trip(int64_t(INT64_MIN)).as_int(), Eq(INT64_MIN));
+    EXPECT_THAT(round_trip(0.5).as_float(), Eq(0.5));
+    EXPECT_THAT(round_trip(-1e300).as_float(), Eq(-1e300));
+    EXPECT_THAT(round_trip("").as_string(), Eq(""));
+    EXPECT_THAT(round_trip("ships/ishiman/cruiser").as_string(), Eq("ships/ishiman/cruiser"));
+}
+
+TEST_F(CompiledScenarioTest, Containers) {
+    pn::value x = pn::map{
+            {"name", "Cruiser"},
+            {"frames", pn::array{1, 2.5, nullptr}},
+            {"nested", pn::map{{"empty", pn::map{}}, {"list", pn::array{}}}},
+    };
+    pn::string expected = pn::dump(x);
+    EXPECT_THAT(pn::dump(round_trip(x)), Eq(pn::string_view{expected}));
+}
+
+TEST_F(CompiledScenarioTest, Malformed) {
+    const uint8_t truncated[] = {'s', 5, 'a', 'b'};
+    EXPECT_THROW(decode_value(pn::data_view{truncated, 4}), std::runtime_error);
+    const uint8_t trailing[] = {'n', 'n'};
+    EXPECT_THROW(decode_value(pn::data_view{trailing, 2}), std::runtime_error);
+    const uint8_t unknown[] = {'?'};
+    EXPECT_THROW(decode_value(pn::data_view{unknown, 1}), std::runtime_error);
+}
+
+sfz::sha1::digest digest_of(pn::string_view s) {
+    sfz::sha1 sha;
+    sha.write(s);
+    return sha.compute();
+}
+
+std::map<pn::string, pn::value> scenario() {
+    std::map<pn::string, pn::value> values;
+    values.emplace("levels/1.pn", pn::map{{"name", "Space Race"}, {"chapter", 1}});
+    values.emplace("objects/ishiman/cruiser.pn", pn::map{{"long_name", "Cruiser"}});
+    return values;
+}
+
+pn::string image_path(pn::string_view name) {
+    return pn::format("{0}/test/{1}.pnc", dirs().cache, name);
+}
+
+TEST_F(CompiledScenarioTest, WriteOpen) {
+    pn::string path = image_path("write-open");
+    CompiledScenario::write(path, digest_of("sources"), scenario());
+
+    auto compiled = CompiledScenario::open(path, digest_of("sources"));
+    ASSERT_THAT(compiled, NotNull());
+    auto level = compiled->get("levels/1.pn");
+    ASSERT_TRUE(level.has_value());
+    EXPECT_THAT(level->as_map().get("name").as_string(), Eq("Space Race"));
+    EXPECT_THAT(level->as_map().get("chapter").as_int(), Eq(1));
+    auto cruiser = compiled->get("objects/ishiman/cruiser.pn");
+    ASSERT_TRUE(cruiser.has_value());
+    EXPECT_THAT(cruiser->as_map().get("long_name").as_string(), Eq("Cruiser"));
+    EXPECT_FALSE(compiled->get("levels/2.pn").has_value());
+}
+
+TEST_F(CompiledScenarioTest, StaleDigest) {
+    pn::string path = image_path("stale-digest");
+    CompiledScenario::write(path, digest_of("old sources"), scenario());
+    EXPECT_THAT(CompiledScenario::open(path, digest_of("new sources")), IsNull());
+    EXPECT_THAT(CompiledScenario::open(image_path("missing"), digest_of("sources")), IsNull());
+}
+
+TEST_F(CompiledScenarioTest, Truncated) {
+    pn::string path = image_path("truncated");
+    CompiledScenario::write(path, digest_of("sources"), scenario());
+    pn::data image;
+    {
+        sfz::mapped_file file(path);
+        image = file.data().slice(0, file.data().size() - 1).copy();
+    }
+    pn::output{path, pn::binary}.write(image).check();
+    EXPECT_THAT(CompiledScenario::open(path, digest_of("sources")), IsNull());
+
+    pn::output{path, pn::binary}.write(image.slice(0, 10)).check();
+    EXPECT_THAT(CompiledScenario::open(path, digest_of("sources")), IsNull());
+}
+
+}  // namespace
+}  // namespace antares
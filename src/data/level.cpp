@@ -63,15 +63,23 @@ Level::~Level() {
     }
 }
 
-const Level* Level::get(int number) { return plug.chapters[number]; }
+const Level* Level::get(int number) {
+    auto it = plug.chapters.find(number);
+    if (it == plug.chapters.end()) {
+        return nullptr;
+    }
+    return get(it->second);
+}
 
+// Levels are only read in full the first time they are needed.
 const Level* Level::get(pn::string_view name) {
     auto it = plug.levels.find(name.copy());
-    if (it == plug.levels.end()) {
-        return nullptr;
-    } else {
+    if (it != plug.levels.end()) {
         return &it->second;
+    } else if (plug.level_index.find(name.copy()) == plug.level_index.end()) {
+        return nullptr;
     }
+    return &plug.levels.emplace(name.copy(), Resource::level(name)).first->second;
 }
 
 FIELD_READER(LevelBase::PlayerType) {
@@ -174,6 +182,15 @@ static Level net_level(path_value x) {
                 {"foe_no_ships", &NetLevel::foe_no_ships}});
 }
 
+LevelInfo level_info(pn::value_cref x0) {
+    path_value x{x0};
+    LevelInfo  info;
+    info.type    = required_object_type(x, read_field<Level::Type>);
+    info.chapter = read_field<sfz::optional<int64_t>>(x.get("chapter"));
+    info.name    = read_field<pn::string>(x.get("title"));
+    return info;
+}
+
 Level level(pn::value_cref x0) {
     path_value x{x0};
     switch (required_object_type(x, read_field<Level::Type>)) {
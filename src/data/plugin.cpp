@@ -25,7 +25,9 @@
 
 #include "config/dirs.hpp"
 #include "config/preferences.hpp"
+#include "data/asset-cache.hpp"
 #include "data/base-object.hpp"
+#include "data/compiled-scenario.hpp"
 #include "data/condition.hpp"
 #include "data/field.hpp"
 #include "data/initial.hpp"
@@ -49,20 +51,51 @@ static constexpr const char kStarmapPicture[] = "starmap";
 
 ANTARES_GLOBAL ScenarioGlobals plug;
 
-static void read_all_levels() {
+// How many bytes of objects to keep cached between levels.
+static constexpr size_t kObjectCacheBytes = 4 << 20;
+
+static ANTARES_GLOBAL AssetCache<pn::string, BaseObject> object_cache{kObjectCacheBytes};
+
+// Counts the object, its names, and its lists of actions and fire points.  Actions own further
+// data of their own, which isn't counted, so this is an estimate.
+static size_t object_bytes(const BaseObject& o) {
+    size_t bytes = sizeof(BaseObject) + o.long_name.size() + o.short_name.size();
+    for (const auto* weapon : {&o.weapons.pulse, &o.weapons.beam, &o.weapons.special}) {
+        if (weapon->has_value()) {
+            bytes += (*weapon)->positions.size() * sizeof(fixedPointType);
+        }
+    }
+    for (const auto* actions :
+         {&o.destroy.action, &o.expire.action, &o.create.action, &o.collide.action,
+          &o.activate.action, &o.arrive.action}) {
+        bytes += actions->size() * sizeof(Action);
+    }
+    return bytes;
+}
+
+static void index_levels() {
     plug.levels.clear();
+    plug.level_index.clear();
     plug.chapters.clear();
     for (pn::string_view name : Resource::list_levels()) {
-        auto it = plug.levels.emplace(name.copy(), Resource::level(name)).first;
-        if (it->second.base.chapter.has_value()) {
-            plug.chapters[*it->second.base.chapter] = &it->second;
+        auto it = plug.level_index.emplace(name.copy(), Resource::level_info(name)).first;
+        if (it->second.chapter.has_value()) {
+            plug.chapters[*it->second.chapter] = name.copy();
         }
     }
 }
 
 void PluginInit(sfz::optional<pn::string_view> path) {
-    plug.dir = sfz::nullopt;
-    plug.zip = nullptr;
+    // Anything cached came from the previous plugin.
+    object_cache.clear();
+    sys.pix.flush();
+    sys.sound.flush();
+    plug.templates.clear();
+    Resource::flush();
+
+    plug.compiled = nullptr;
+    plug.dir      = sfz::nullopt;
+    plug.zip      = nullptr;
     if (path.has_value()) {
         if (path::isdir(*path)) {
             plug.dir.emplace(path->copy());
@@ -70,6 +103,7 @@ void PluginInit(sfz::optional<pn::string_view> path) {
             plug.zip.reset(new zipxx::ZipArchive(*path, 0));
         }
     }
+    Resource::index();
 
     plug.info = Resource::info();
     try {
@@ -83,7 +117,10 @@ void PluginInit(sfz::optional<pn::string_view> path) {
         std::throw_with_nested(std::runtime_error("info.pn"));
     }
 
-    read_all_levels();
+    plug.compiled = Resource::compiled(
+            pn::format("{0}/{1}.pnc", dirs().cache, plug.info.identifier.hash));
+
+    index_levels();
 }
 
 void load_race(const NamedHandle<const Race>& r) {
@@ -97,7 +134,23 @@ void load_object(const NamedHandle<const BaseObject>& o) {
     if (plug.objects.find(o.name().copy()) != plug.objects.end()) {
         return;  // already loaded.
     }
-    plug.objects.emplace(o.name().copy(), Resource::object(o.name()));
+    sfz::optional<BaseObject> cached = object_cache.take(o.name().copy());
+    if (cached.has_value()) {
+        plug.objects.emplace(o.name().copy(), std::move(*cached));
+    } else {
+        plug.objects.emplace(o.name().copy(), Resource::object(o.name()));
+    }
+}
+
+// Races are few and small, and Race::get() can insert placeholder entries, so they are simply
+// dropped rather than cached.
+void unload_objects() {
+    plug.races.clear();
+    for (auto& kv : plug.objects) {
+        size_t bytes = object_bytes(kv.second);
+        object_cache.put(kv.first.copy(), std::move(kv.second), bytes);
+    }
+    plug.objects.clear();
 }
 
 }  // namespace antares
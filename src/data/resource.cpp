@@ -20,16 +20,20 @@
 
 #include <stdio.h>
 
+#include <algorithm>
 #include <array>
+#include <mutex>
 #include <pn/input>
 #include <sfz/sfz.hpp>
 #include <zipxx/zipxx.hpp>
 
 #include "config/dirs.hpp"
 #include "config/preferences.hpp"
+#include "data/asset-cache.hpp"
 #include "data/audio.hpp"
 #include "data/base-object.hpp"
 #include "data/briefing.hpp"
+#include "data/compiled-scenario.hpp"
 #include "data/condition.hpp"
 #include "data/field.hpp"
 #include "data/font-data.hpp"
@@ -43,6 +47,7 @@
 #include "data/sprite-data.hpp"
 #include "drawing/text.hpp"
 #include "game/sys.hpp"
+#include "lang/defines.hpp"
 #include "video/driver.hpp"
 
 namespace path = sfz::path;
@@ -82,6 +87,83 @@ class ResourceLister : public sfz::TreeWalker {
     std::vector<pn::string>* const _names;
 };
 
+// libzip handles may not be used from two threads at once, and sprites are read by background
+// threads while a level loads.
+static std::mutex zip_mutex;
+
+// How many bytes of decompressed zip entries to keep, so that sprites and sounds read again by a
+// later level aren't decompressed again.
+static constexpr size_t kZipEntryCacheBytes = 32 << 20;
+
+using ZipEntry = std::shared_ptr<const zipxx::ZipFileReader>;
+
+// Decompressed entries of `plug.zip`, by index.  Guarded by `zip_mutex`, and emptied by
+// Resource::flush() when the plugin changes.
+static ANTARES_GLOBAL AssetCache<int64_t, ZipEntry> zip_entry_cache{kZipEntryCacheBytes};
+
+// Returns entry `index` of `zip`, decompressing it only if it isn't cached.  Requires
+// `zip_mutex`.
+static ZipEntry zip_entry(const zipxx::ZipArchive& zip, int64_t index) {
+    sfz::optional<ZipEntry> cached = zip_entry_cache.take(index);
+    ZipEntry                file   = cached.has_value()
+                                     ? std::move(*cached)
+                                     : std::make_shared<const zipxx::ZipFileReader>(zip, index);
+    zip_entry_cache.put(index, file, file->data().size());
+    return file;
+}
+
+// The places that a resource may be found, in the order that they are searched.
+enum class Layer { PLUGIN_DIR, PLUGIN_ZIP, FACTORY, APPLICATION };
+
+struct Location {
+    Layer   layer;
+    int64_t zip_index;  // For PLUGIN_ZIP only.
+};
+
+// Where each resource is found, built by Resource::index() so that finding a resource doesn't
+// mean probing each layer in turn.  Until it is built, resources are found by probing.
+static ANTARES_GLOBAL sfz::optional<std::map<pn::string, Location>> resource_index;
+
+static pn::string_view layer_dir(Layer layer) {
+    switch (layer) {
+        case Layer::PLUGIN_DIR: return *plug.dir;
+        case Layer::FACTORY: return factory_scenario_path();
+        case Layer::APPLICATION:
+        case Layer::PLUGIN_ZIP: break;
+    }
+    return application_path();
+}
+
+class ResourceIndexer : public sfz::TreeWalker {
+  public:
+    ResourceIndexer(pn::string_view root, Layer layer, std::map<pn::string, Location>* index)
+            : _root_size(root.size()), _layer(layer), _index(index) {}
+
+    void file(pn::string_view name, const sfz::Stat& st) const override { add(name); }
+
+    void symlink(pn::string_view name, const sfz::Stat& st) const override {
+        if (path::isfile(name)) {
+            add(name);
+        }
+    }
+
+    void pre_directory(pn::string_view name, const sfz::Stat& st) const override {}
+    void cycle_directory(pn::string_view name, const sfz::Stat& st) const override {}
+    void post_directory(pn::string_view name, const sfz::Stat& st) const override {}
+    void broken_symlink(pn::string_view name, const sfz::Stat& st) const override {}
+    void other(pn::string_view name, const sfz::Stat& st) const override {}
+
+  private:
+    // Earlier layers are indexed first, and take precedence.
+    void add(pn::string_view name) const {
+        _index->emplace(name.substr(_root_size + 1).copy(), Location{_layer, -1});
+    }
+
+    const int                             _root_size;
+    const Layer                           _layer;
+    std::map<pn::string, Location>* const _index;
+};
+
 class ResourceData {
   public:
     static bool exists(pn::string_view dir, pn::string_view resource_path) {
@@ -89,6 +171,7 @@ class ResourceData {
     }
 
     static bool exists(const zipxx::ZipArchive& zip, pn::string_view resource_path) {
+        std::unique_lock<std::mutex> lock(zip_mutex);
         return zip.locate(resource_path.copy().c_str()) != zip.npos;
     }
 
@@ -102,15 +185,29 @@ class ResourceData {
     }
 
     bool load(const zipxx::ZipArchive& zip, pn::string_view resource_path) {
+        std::unique_lock<std::mutex> lock(zip_mutex);
         auto index = zip.locate(resource_path.copy().c_str());
         if (index < 0) {
             return false;
         }
-        _zip_file.reset(new zipxx::ZipFileReader(zip, index));
+        _zip_file = zip_entry(zip, index);
         return true;
     }
 
+    void load(const Location& location, pn::string_view resource_path) {
+        if (location.layer == Layer::PLUGIN_ZIP) {
+            std::unique_lock<std::mutex> lock(zip_mutex);
+            _zip_file = zip_entry(*plug.zip, location.zip_index);
+        } else {
+            _dir_file.reset(new sfz::mapped_file(
+                    pn::format("{0}/{1}", layer_dir(location.layer), resource_path)));
+        }
+    }
+
     static bool exists(pn::string_view resource_path) {
+        if (resource_index.has_value()) {
+            return resource_index->find(resource_path.copy()) != resource_index->end();
+        }
         return (plug.dir.has_value() && exists(*plug.dir, resource_path)) ||
                (plug.zip && exists(*plug.zip, resource_path)) ||
                exists(factory_scenario_path(), resource_path) ||
@@ -119,10 +216,16 @@ class ResourceData {
 
     static ResourceData load(pn::string_view resource_path) {
         ResourceData data;
-        if ((plug.dir.has_value() && data.load(*plug.dir, resource_path)) ||
-            (plug.zip && data.load(*plug.zip, resource_path)) ||
-            data.load(factory_scenario_path(), resource_path) ||
-            data.load(application_path(), resource_path)) {
+        if (resource_index.has_value()) {
+            auto it = resource_index->find(resource_path.copy());
+            if (it != resource_index->end()) {
+                data.load(it->second, resource_path);
+                return data;
+            }
+        } else if ((plug.dir.has_value() && data.load(*plug.dir, resource_path)) ||
+                   (plug.zip && data.load(*plug.zip, resource_path)) ||
+                   data.load(factory_scenario_path(), resource_path) ||
+                   data.load(application_path(), resource_path)) {
             return data;
         }
         throw std::runtime_error(
@@ -173,8 +276,8 @@ class ResourceData {
   private:
     ResourceData() {}
 
-    std::unique_ptr<sfz::mapped_file>     _dir_file;
-    std::unique_ptr<zipxx::ZipFileReader> _zip_file;
+    std::unique_ptr<sfz::mapped_file> _dir_file;
+    ZipEntry                          _zip_file;
 };
 
 static bool startswith(pn::string_view s, pn::string_view prefix) {
@@ -213,10 +316,45 @@ static std::vector<pn::string> list_resources(pn::string_view dir, pn::string_vi
     return resources;
 }
 
+static void index_dir(pn::string_view dir, Layer layer, std::map<pn::string, Location>* index) {
+    if (sfz::path::isdir(dir)) {
+        sfz::walk(dir, sfz::WALK_PHYSICAL, ResourceIndexer(dir, layer, index));
+    }
+}
+
+void Resource::flush() {
+    std::unique_lock<std::mutex> lock(zip_mutex);
+    zip_entry_cache.clear();
+}
+
+void Resource::index() {
+    std::map<pn::string, Location> index;
+    if (plug.dir.has_value()) {
+        index_dir(*plug.dir, Layer::PLUGIN_DIR, &index);
+    } else if (plug.zip) {
+        for (auto i : sfz::range(plug.zip->size())) {
+            index.emplace(plug.zip->name(i).copy(), Location{Layer::PLUGIN_ZIP, int64_t(i)});
+        }
+    }
+    index_dir(factory_scenario_path(), Layer::FACTORY, &index);
+    index_dir(application_path(), Layer::APPLICATION, &index);
+    resource_index.emplace(std::move(index));
+}
+
 std::vector<pn::string> Resource::list_levels() { return list_resources("levels", ".pn"); }
 std::vector<pn::string> Resource::list_replays() { return list_resources("replays", ".NLRP"); }
 
 static pn::value procyon(pn::string_view path) {
+    if (plug.compiled) {
+        try {
+            sfz::optional<pn::value> x = plug.compiled->get(path);
+            if (x.has_value()) {
+                return std::move(*x);
+            }
+        } catch (std::runtime_error&) {
+            // Damaged since it was written; fall back to the text.
+        }
+    }
     pn::value  x;
     pn_error_t e;
     if (!pn::parse(ResourceData::load(path).data().input(), &x, &e)) {
@@ -227,6 +365,46 @@ static pn::value procyon(pn::string_view path) {
     return x;
 }
 
+std::unique_ptr<CompiledScenario> Resource::compiled(pn::string_view cache_path) {
+    std::vector<pn::string> paths;
+    for (pn::string_view dir : {"levels", "objects", "races", "sprites"}) {
+        for (pn::string_view name : list_resources(dir, ".pn")) {
+            paths.push_back(pn::format("{0}/{1}.pn", dir, name));
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    sfz::sha1                 sha;
+    std::vector<ResourceData> sources;
+    for (const pn::string& path : paths) {
+        sources.push_back(ResourceData::load(path));
+        sha.write(pn::format("{0}\n{1}\n", path, sources.back().data().size()));
+        sha.write(sources.back().data());
+    }
+    sfz::sha1::digest digest = sha.compute();
+
+    std::unique_ptr<CompiledScenario> compiled = CompiledScenario::open(cache_path, digest);
+    if (compiled) {
+        return compiled;
+    }
+
+    // Sources that don't parse are left out, so that reading them reports the error as usual.
+    std::map<pn::string, pn::value> values;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        pn::value  x;
+        pn_error_t e;
+        if (pn::parse(sources[i].data().input(), &x, &e)) {
+            values.emplace(paths[i].copy(), std::move(x));
+        }
+    }
+    try {
+        CompiledScenario::write(cache_path, digest, values);
+    } catch (std::runtime_error&) {
+        return nullptr;
+    }
+    return CompiledScenario::open(cache_path, digest);
+}
+
 static pn::value info_procyon() {
     pn::value  x;
     pn_error_t e;
@@ -315,6 +493,15 @@ InterfaceData Resource::interface(pn::string_view name) {
     }
 }
 
+LevelInfo Resource::level_info(pn::string_view name) {
+    pn::string path = pn::format("levels/{0}.pn", name);
+    try {
+        return ::antares::level_info(procyon(path));
+    } catch (...) {
+        std::throw_with_nested(std::runtime_error(path.c_str()));
+    }
+}
+
 Level Resource::level(pn::string_view name) {
     pn::string path = pn::format("levels/{0}.pn", name);
     try {
@@ -340,19 +527,31 @@ static void merge_value(pn::value_ref base, pn::value_cref patch) {
 
         case PN_MAP: break;
     }
+    // Merges in place, so that only the parts of `base` that `patch` replaces are copied.
     pn::map_ref m = base.to_map();
     for (pn::key_value_cref kv : patch.as_map()) {
         pn::string_view k = kv.key();
         if (m.has(k)) {
-            pn::value v = m.get(k).copy();
-            merge_value(v, patch.as_map().get(k));
-            m.set(k, std::move(v));
+            merge_value(m.get(k), kv.value());
         } else {
             m.set(k, kv.value().copy());
         }
     }
 }
 
+static pn::value merged_object(pn::string_view name);
+
+// Returns the merged object `name`, to be used as the template of another object.  Templates
+// are shared by many objects, such as all the ships of a race, so each is merged only once per
+// plugin, and kept in plug.templates.
+static pn::value_cref merged_template(pn::string_view name) {
+    auto it = plug.templates.find(name.copy());
+    if (it == plug.templates.end()) {
+        it = plug.templates.emplace(name.copy(), merged_object(name)).first;
+    }
+    return it->second;
+}
+
 static pn::value merged_object(pn::string_view name) {
     pn::string path = pn::format("objects/{0}.pn", name);
     try {
@@ -361,7 +560,7 @@ static pn::value merged_object(pn::string_view name) {
         if (!x.is_map() || !x.to_map().pop("template", &tpl) || tpl.is_null()) {
             return x;
         } else if (tpl.is_string()) {
-            pn::value base = merged_object(tpl.as_string());
+            pn::value base = merged_template(tpl.as_string()).copy();
             merge_value(base, x);
             return base;
         } else {
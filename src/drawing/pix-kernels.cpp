@@ -0,0 +1,220 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include "drawing/pix-kernels.hpp"
+
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define ANTARES_PIX_SSE2 1
+#elif defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_neon.h>
+#define ANTARES_PIX_NEON 1
+#endif
+
+namespace antares {
+
+static_assert(sizeof(RgbColor) == 4, "RgbColor must be packed");
+
+namespace {
+
+// Mixes `over` into `under` by `frac`/255.
+inline uint8_t mix(uint8_t over, uint8_t under, uint8_t frac) {
+    return ((over * frac) + (under * (255 - frac))) / 255;
+}
+
+// Draws `over` on top of `under`, neither of which has premultiplied alpha.
+inline RgbColor composite_pixel(RgbColor over, RgbColor under) {
+    // An opaque pixel covers what's under it, and a clear one leaves an opaque pixel as it is.
+    // The arithmetic below gives exactly the same in both cases.
+    if (over.alpha == 255) {
+        return over;
+    } else if ((over.alpha == 0) && (under.alpha == 255)) {
+        return under;
+    }
+
+    // TODO(sfiera): if we're going to do anything like this in the long run, we should require
+    // that alpha be pre-multiplied with the color components.  We should probably also use
+    // integral arithmetic.
+    const double oa    = over.alpha / 255.0;
+    const double ua    = under.alpha / 255.0;
+    double       red   = (over.red * oa) + ((under.red * ua) * (1.0 - oa));
+    double       green = (over.green * oa) + ((under.green * ua) * (1.0 - oa));
+    double       blue  = (over.blue * oa) + ((under.blue * ua) * (1.0 - oa));
+    double       alpha = oa + (ua * (1.0 - oa));
+    return rgba(red / alpha, green / alpha, blue / alpha, alpha * 255);
+}
+
+#if defined(ANTARES_PIX_SSE2)
+
+// For x in [0, 255 * 255], (x + 1 + (x >> 8)) >> 8 is exactly x / 255.
+inline __m128i div255(__m128i x) {
+    return _mm_srli_epi16(
+            _mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+// Mixes two pixels widened to 16 bits a channel, keeping the alpha of `under`.
+inline __m128i mix2(__m128i over, __m128i under, __m128i frac) {
+    const __m128i alpha = _mm_set_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+    const __m128i inv   = _mm_sub_epi16(_mm_set1_epi16(255), frac);
+    const __m128i sum   = _mm_add_epi16(_mm_mullo_epi16(over, frac), _mm_mullo_epi16(under, inv));
+    return _mm_or_si128(_mm_andnot_si128(alpha, div255(sum)), _mm_and_si128(alpha, under));
+}
+
+// Copies the alpha of each of two widened pixels into all four of its channels.
+inline __m128i splat_alpha(__m128i x) {
+    return _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(x, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+}
+
+#endif  // defined(ANTARES_PIX_SSE2)
+
+}  // namespace
+
+void overlay_row(RgbColor* dst, const RgbColor* overlay, const RgbColor (&tints)[256], int width) {
+    int x = 0;
+#if defined(ANTARES_PIX_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 4 <= width; x += 4) {
+        const RgbColor tinted[4] = {
+                tints[overlay[x].red], tints[overlay[x + 1].red], tints[overlay[x + 2].red],
+                tints[overlay[x + 3].red]};
+        const __m128i over  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tinted));
+        const __m128i frac  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(overlay + x));
+        const __m128i under = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + x));
+        const __m128i lo    = mix2(
+                _mm_unpacklo_epi8(over, zero), _mm_unpacklo_epi8(under, zero),
+                splat_alpha(_mm_unpacklo_epi8(frac, zero)));
+        const __m128i hi = mix2(
+                _mm_unpackhi_epi8(over, zero), _mm_unpackhi_epi8(under, zero),
+                splat_alpha(_mm_unpackhi_epi8(frac, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(ANTARES_PIX_NEON)
+    const uint8x16_t alpha = vreinterpretq_u8_u32(vdupq_n_u32(0xff));
+    for (; x + 4 <= width; x += 4) {
+        const RgbColor tinted[4] = {
+                tints[overlay[x].red], tints[overlay[x + 1].red], tints[overlay[x + 2].red],
+                tints[overlay[x + 3].red]};
+        const uint8x16_t over  = vld1q_u8(reinterpret_cast<const uint8_t*>(tinted));
+        const uint8x16_t under = vld1q_u8(reinterpret_cast<const uint8_t*>(dst + x));
+        // Multiplying the alpha byte by 0x01010101 copies it into the other three.
+        const uint32x4_t bits = vld1q_u32(reinterpret_cast<const uint32_t*>(overlay + x));
+        const uint8x16_t frac =
+                vreinterpretq_u8_u32(vmulq_n_u32(vandq_u32(bits, vdupq_n_u32(0xff)), 0x01010101));
+        const uint8x16_t inv = vsubq_u8(vdupq_n_u8(255), frac);
+        uint16x8_t       lo  = vmull_u8(vget_low_u8(over), vget_low_u8(frac));
+        uint16x8_t       hi  = vmull_u8(vget_high_u8(over), vget_high_u8(frac));
+        lo                   = vmlal_u8(lo, vget_low_u8(under), vget_low_u8(inv));
+        hi                   = vmlal_u8(hi, vget_high_u8(under), vget_high_u8(inv));
+        // Divides by 255, as div255() does above.
+        lo = vshrq_n_u16(vaddq_u16(vaddq_u16(lo, vdupq_n_u16(1)), vshrq_n_u16(lo, 8)), 8);
+        hi = vshrq_n_u16(vaddq_u16(vaddq_u16(hi, vdupq_n_u16(1)), vshrq_n_u16(hi, 8)), 8);
+        const uint8x16_t mixed = vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+        vst1q_u8(reinterpret_cast<uint8_t*>(dst + x), vbslq_u8(alpha, under, mixed));
+    }
+#endif
+    for (; x < width; ++x) {
+        const RgbColor& over  = tints[overlay[x].red];
+        const uint8_t   frac  = overlay[x].alpha;
+        RgbColor&       under = dst[x];
+        under.red             = mix(over.red, under.red, frac);
+        under.green           = mix(over.green, under.green, frac);
+        under.blue            = mix(over.blue, under.blue, frac);
+    }
+}
+
+void composite_row(RgbColor* dst, const RgbColor* src, int width) {
+    // Read as little-endian words, alpha is the low byte of each pixel.
+    int x = 0;
+#if defined(ANTARES_PIX_SSE2)
+    const __m128i alpha = _mm_set1_epi32(0xff);
+    for (; x + 4 <= width; x += 4) {
+        const __m128i over       = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+        const __m128i over_alpha = _mm_and_si128(over, alpha);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(over_alpha, alpha)) == 0xffff) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), over);
+            continue;
+        }
+        const __m128i under = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + x));
+        const __m128i keep  = _mm_and_si128(
+                _mm_cmpeq_epi32(over_alpha, _mm_setzero_si128()),
+                _mm_cmpeq_epi32(_mm_and_si128(under, alpha), alpha));
+        if (_mm_movemask_epi8(keep) == 0xffff) {
+            continue;
+        }
+        for (int i = x; i < x + 4; ++i) {
+            dst[i] = composite_pixel(src[i], dst[i]);
+        }
+    }
+#elif defined(ANTARES_PIX_NEON)
+    const uint32x4_t alpha = vdupq_n_u32(0xff);
+    for (; x + 4 <= width; x += 4) {
+        const uint32x4_t over       = vld1q_u32(reinterpret_cast<const uint32_t*>(src + x));
+        const uint32x4_t over_alpha = vandq_u32(over, alpha);
+        uint32x4_t       all        = vceqq_u32(over_alpha, alpha);
+        uint32x2_t       half       = vand_u32(vget_low_u32(all), vget_high_u32(all));
+        if (vget_lane_u32(half, 0) & vget_lane_u32(half, 1)) {
+            vst1q_u32(reinterpret_cast<uint32_t*>(dst + x), over);
+            continue;
+        }
+        const uint32x4_t under = vld1q_u32(reinterpret_cast<const uint32_t*>(dst + x));
+        all  = vandq_u32(
+                vceqq_u32(over_alpha, vdupq_n_u32(0)), vceqq_u32(vandq_u32(under, alpha), alpha));
+        half = vand_u32(vget_low_u32(all), vget_high_u32(all));
+        if (vget_lane_u32(half, 0) & vget_lane_u32(half, 1)) {
+            continue;
+        }
+        for (int i = x; i < x + 4; ++i) {
+            dst[i] = composite_pixel(src[i], dst[i]);
+        }
+    }
+#endif
+    for (; x < width; ++x) {
+        dst[x] = composite_pixel(src[x], dst[x]);
+    }
+}
+
+void bgra_row(RgbColor* dst, const uint8_t* bgra, int width) {
+    // Read as little-endian words, BGRA becomes ARGB with its bytes reversed: reverse them back,
+    // and set the alpha, which is then the low byte.
+    int x = 0;
+#if defined(ANTARES_PIX_SSE2)
+    const __m128i alpha = _mm_set1_epi32(0xff);
+    for (; x + 4 <= width; x += 4) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bgra + 4 * x));
+        p         = _mm_or_si128(_mm_slli_epi16(p, 8), _mm_srli_epi16(p, 8));
+        p         = _mm_shufflehi_epi16(
+                _mm_shufflelo_epi16(p, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_or_si128(p, alpha));
+    }
+#elif defined(ANTARES_PIX_NEON)
+    const uint8x16_t alpha = vreinterpretq_u8_u32(vdupq_n_u32(0xff));
+    for (; x + 4 <= width; x += 4) {
+        const uint8x16_t p = vrev32q_u8(vld1q_u8(bgra + 4 * x));
+        vst1q_u8(reinterpret_cast<uint8_t*>(dst + x), vorrq_u8(p, alpha));
+    }
+#endif
+    for (; x < width; ++x) {
+        dst[x] = rgb(bgra[4 * x + 2], bgra[4 * x + 1], bgra[4 * x + 0]);
+    }
+}
+
+}  // namespace antares
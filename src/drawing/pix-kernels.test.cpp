@@ -0,0 +1,138 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "drawing/pix-kernels.hpp"
+
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <vector>
+
+using testing::ElementsAreArray;
+
+namespace antares {
+namespace {
+
+using PixKernelsTest = testing::Test;
+
+// The per-pixel loop that overlay_row() replaced.
+RgbColor overlay_pixel(RgbColor under, RgbColor over, Hue hue) {
+    uint8_t frac = over.alpha;
+    over         = RgbColor::tint(hue, over.red);
+    RgbColor composite;
+    composite.red   = ((over.red * frac) + (under.red * (255 - frac))) / 255;
+    composite.green = ((over.green * frac) + (under.green * (255 - frac))) / 255;
+    composite.blue  = ((over.blue * frac) + (under.blue * (255 - frac))) / 255;
+    composite.alpha = under.alpha;
+    return composite;
+}
+
+// Every combination of shade and alpha over a spread of underlying colors, in rows whose widths
+// aren't all multiples of the vector size, so that leftover pixels are covered too.
+TEST_F(PixKernelsTest, Overlay) {
+    for (Hue hue : {Hue::GRAY, Hue::ORANGE, Hue::SKY_BLUE, Hue::TAN}) {
+        RgbColor tints[256];
+        for (int shade = 0; shade < 256; ++shade) {
+            tints[shade] = RgbColor::tint(hue, shade);
+        }
+        for (int under : {0, 1, 85, 127, 128, 170, 254, 255}) {
+            std::vector<RgbColor> overlay, under_pix, expected;
+            for (int shade = 0; shade < 256; ++shade) {
+                for (int frac = 0; frac < 256; ++frac) {
+                    RgbColor over = rgba(shade, 0, 0, frac);
+                    RgbColor pix  = rgba(under, 255 - under, under ^ 0x55, frac ^ under);
+                    overlay.push_back(over);
+                    under_pix.push_back(pix);
+                    expected.push_back(overlay_pixel(pix, over, hue));
+                }
+            }
+            for (int width : {1, 3, 4, 13}) {
+                std::vector<RgbColor> dst = under_pix;
+                for (int x = 0; x < int(dst.size()); x += width) {
+                    overlay_row(&dst[x], &overlay[x], tints, std::min<int>(width, dst.size() - x));
+                }
+                EXPECT_THAT(dst, ElementsAreArray(expected)) << "width " << width;
+            }
+        }
+    }
+}
+
+// The per-pixel loop that composite_row() replaced.
+RgbColor composite_pixel(RgbColor under, RgbColor over) {
+    const double oa    = over.alpha / 255.0;
+    const double ua    = under.alpha / 255.0;
+    double       red   = (over.red * oa) + ((under.red * ua) * (1.0 - oa));
+    double       green = (over.green * oa) + ((under.green * ua) * (1.0 - oa));
+    double       blue  = (over.blue * oa) + ((under.blue * ua) * (1.0 - oa));
+    double       alpha = oa + (ua * (1.0 - oa));
+    return rgba(red / alpha, green / alpha, blue / alpha, alpha * 255);
+}
+
+// Every alpha over a spread of underlying alphas and colors, followed by runs of opaque pixels
+// and of clear pixels over opaque ones, which are handled four at a time.  Clear pixels over
+// clear ones are left out: the old loop divided zero by zero for them.
+TEST_F(PixKernelsTest, Composite) {
+    std::vector<RgbColor> src, under_pix, expected;
+    auto                  add = [&src, &under_pix, &expected](RgbColor over, RgbColor under) {
+        src.push_back(over);
+        under_pix.push_back(under);
+        expected.push_back(composite_pixel(under, over));
+    };
+    for (int over_alpha = 0; over_alpha < 256; ++over_alpha) {
+        for (int under_alpha : {0, 1, 85, 128, 254, 255}) {
+            for (int color : {0, 1, 127, 128, 254, 255}) {
+                if ((over_alpha == 0) && (under_alpha == 0)) {
+                    continue;
+                }
+                add(rgba(color, 255 - color, color ^ 0x55, over_alpha),
+                    rgba(255 - color, color ^ 0xaa, color, under_alpha));
+            }
+        }
+    }
+    for (int i = 0; i < 64; ++i) {
+        add(rgba(i, 2 * i, 3 * i, 255), rgba(3 * i, i, 2 * i, i % 4 ? 255 : i));
+    }
+    for (int i = 0; i < 64; ++i) {
+        add(rgba(i, 2 * i, 3 * i, 0), rgba(3 * i, i, 2 * i, 255));
+    }
+
+    for (int width : {1, 3, 4, 13, 16}) {
+        std::vector<RgbColor> dst = under_pix;
+        for (int x = 0; x < int(dst.size()); x += width) {
+            composite_row(&dst[x], &src[x], std::min<int>(width, dst.size() - x));
+        }
+        EXPECT_THAT(dst, ElementsAreArray(expected)) << "width " << width;
+    }
+}
+
+TEST_F(PixKernelsTest, Bgra) {
+    for (int width : {0, 1, 4, 7, 16, 17}) {
+        std::vector<uint8_t>  bgra;
+        std::vector<RgbColor> expected;
+        for (int x = 0; x < width; ++x) {
+            uint8_t b = 3 * x, g = 5 * x + 1, r = 7 * x + 2, a = 11 * x + 3;
+            bgra.insert(bgra.end(), {b, g, r, a});
+            expected.push_back(rgb(r, g, b));
+        }
+        std::vector<RgbColor> dst(width, RgbColor::clear());
+        bgra_row(dst.data(), bgra.data(), width);
+        EXPECT_THAT(dst, ElementsAreArray(expected));
+    }
+}
+
+}  // namespace
+}  // namespace antares
@@ -21,7 +21,9 @@
 #include <algorithm>
 #include <pn/output>
 #include <sfz/sfz.hpp>
+#include <vector>
 
+#include "drawing/pix-kernels.hpp"
 #include "lang/casts.hpp"
 
 namespace antares {
@@ -38,9 +40,7 @@ void PixMap::set(int x, int y, const RgbColor& color) { mutable_row(y)[x] = colo
 
 void PixMap::fill(const RgbColor& color) {
     if (size().height > 0) {
-        for (int x = 0; x < size().width; ++x) {
-            set(x, 0, color);
-        }
+        std::fill_n(mutable_row(0), size().width, color);
         for (int y = 1; y < size().height; ++y) {
             memcpy(mutable_row(y), row(y - 1), size().width * sizeof(RgbColor));
         }
@@ -61,21 +61,7 @@ void PixMap::composite(const PixMap& pix) {
         throw std::runtime_error("Mismatch in PixMap sizes");
     }
     for (int y = 0; y < size().height; ++y) {
-        for (int x = 0; x < size().width; ++x) {
-            const RgbColor& over  = pix.get(x, y);
-            const double    oa    = over.alpha / 255.0;
-            const RgbColor& under = get(x, y);
-            const double    ua    = under.alpha / 255.0;
-
-            // TODO(sfiera): if we're going to do anything like this in the long run, we should
-            // require that alpha be pre-multiplied with the color components.  We should probably
-            // also use integral arithmetic.
-            double red   = (over.red * oa) + ((under.red * ua) * (1.0 - oa));
-            double green = (over.green * oa) + ((under.green * ua) * (1.0 - oa));
-            double blue  = (over.blue * oa) + ((under.blue * ua) * (1.0 - oa));
-            double alpha = oa + (ua * (1.0 - oa));
-            set(x, y, rgba(red / alpha, green / alpha, blue / alpha, alpha * 255));
-        }
+        composite_row(mutable_row(y), pix.row(y), size().width);
     }
 }
 
@@ -138,4 +124,21 @@ RgbColor* PixMap::View::mutable_bytes() {
 
 PixMap::View PixMap::view(const Rect& bounds) { return View(this, bounds); }
 
+sfz::sha1::digest PixMap::digest() const {
+    sfz::sha1            sha;
+    std::vector<uint8_t> bytes(size().width * 4);
+    for (int y = 0; y < size().height; ++y) {
+        const RgbColor* in  = row(y);
+        uint8_t*        out = bytes.data();
+        for (int x = 0; x < size().width; ++x) {
+            *(out++) = in[x].red;
+            *(out++) = in[x].green;
+            *(out++) = in[x].blue;
+            *(out++) = in[x].alpha;
+        }
+        sha.write(pn::data_view{bytes.data(), static_cast<int>(bytes.size())});
+    }
+    return sha.compute();
+}
+
 }  // namespace antares
@@ -26,6 +26,7 @@
 #include "data/resource.hpp"
 #include "data/sprite-data.hpp"
 #include "drawing/color.hpp"
+#include "drawing/pix-kernels.hpp"
 #include "game/sys.hpp"
 #include "video/driver.hpp"
 
@@ -36,7 +37,25 @@ using std::vector;
 
 namespace antares {
 
-NatePixTable::NatePixTable(pn::string_view name, Hue hue) {
+namespace {
+
+Rect sprite_rect(const SpriteData::Frame& frame) {
+    return Rect{frame.left, frame.top, frame.right, frame.bottom};
+}
+
+void load_overlay(PixMap& dst, const PixMap& pix, Hue hue) {
+    RgbColor tints[256];
+    for (auto shade : range(256)) {
+        tints[shade] = RgbColor::tint(hue, shade);
+    }
+    for (auto y : range(dst.size().height)) {
+        overlay_row(dst.mutable_row(y), pix.row(y), tints, dst.size().width);
+    }
+}
+
+}  // namespace
+
+NatePixTable::Decoded NatePixTable::decode(pn::string_view name, Hue hue) {
     SpriteData  data    = Resource::sprite_data(name);
     ArrayPixMap image   = Resource::sprite_image(name);
     ArrayPixMap overlay = Resource::sprite_overlay(name);
@@ -44,16 +63,29 @@ NatePixTable::NatePixTable(pn::string_view name, Hue hue) {
     if (image.size() != overlay.size()) {
         throw std::runtime_error("size mismatch between image and overlay");
     }
+    Decoded decoded{name.copy(), hue, {}};
     for (SpriteData::Frame frame : data.frames) {
-        const int i = _frames.size();
-        Rect      sprite{frame.left, frame.top, frame.right, frame.bottom};
-        Rect      bounds = sprite;
+        Rect sprite = sprite_rect(frame);
+        Rect bounds = sprite;
         bounds.offset(-frame.cx, -frame.cy);
-        if (hue == Hue::GRAY) {
-            _frames.emplace_back(bounds, image.view(sprite), name, i);
-        } else {
-            _frames.emplace_back(bounds, image.view(sprite), name, i, overlay.view(sprite), hue);
+        std::unique_ptr<ArrayPixMap> pix(new ArrayPixMap(bounds.width(), bounds.height()));
+        pix->copy(image.view(sprite));
+        if (hue != Hue::GRAY) {
+            load_overlay(*pix, overlay.view(sprite), hue);
         }
+        decoded.frames.push_back(Decoded::Frame{bounds, std::move(pix)});
+    }
+    return decoded;
+}
+
+NatePixTable::NatePixTable(pn::string_view name, Hue hue, PixResidency residency)
+        : NatePixTable(decode(name, hue), residency) {}
+
+NatePixTable::NatePixTable(Decoded decoded, PixResidency residency) {
+    for (auto& frame : decoded.frames) {
+        const int i = _frames.size();
+        _frames.emplace_back(
+                frame.bounds, std::move(frame.pix_map), decoded.name, i, decoded.hue, residency);
     }
 }
 
@@ -61,53 +93,48 @@ NatePixTable::~NatePixTable() {}
 
 const NatePixTable::Frame& NatePixTable::at(size_t index) const { return _frames[index]; }
 
-size_t NatePixTable::size() const { return _size; }
+size_t NatePixTable::size() const { return _frames.size(); }
 
 NatePixTable::Frame::Frame(
-        Rect bounds, const PixMap& image, pn::string_view name, int frame, const PixMap& overlay,
-        Hue hue)
-        : _bounds(bounds), _pix_map(bounds.width(), bounds.height()) {
-    load_image(image);
-    load_overlay(overlay, hue);
-    build(name, frame);
-}
-
-NatePixTable::Frame::Frame(Rect bounds, const PixMap& image, pn::string_view name, int frame)
-        : _bounds(bounds), _pix_map(bounds.width(), bounds.height()) {
-    load_image(image);
-    build(name, frame);
+        Rect bounds, std::unique_ptr<ArrayPixMap> pix_map, pn::string_view name, int frame,
+        Hue hue, PixResidency residency)
+        : _bounds(bounds),
+          _name(name.copy()),
+          _frame(frame),
+          _hue(hue),
+          _pix_map(std::move(pix_map)) {
+    build(residency);
 }
 
 NatePixTable::Frame::~Frame() {}
 
-void NatePixTable::Frame::load_image(const PixMap& pix) { _pix_map.copy(pix); }
-
-void NatePixTable::Frame::load_overlay(const PixMap& pix, Hue hue) {
-    for (auto x : range(width())) {
-        for (auto y : range(height())) {
-            RgbColor over  = pix.get(x, y);
-            uint8_t  value = over.red;
-            uint8_t  frac  = over.alpha;
-            over           = RgbColor::tint(hue, value);
-            RgbColor under = _pix_map.get(x, y);
-            RgbColor composite;
-            composite.red   = ((over.red * frac) + (under.red * (255 - frac))) / 255;
-            composite.green = ((over.green * frac) + (under.green * (255 - frac))) / 255;
-            composite.blue  = ((over.blue * frac) + (under.blue * (255 - frac))) / 255;
-            composite.alpha = under.alpha;
-            _pix_map.set(x, y, composite);
-        }
-    }
-}
-
 uint16_t       NatePixTable::Frame::width() const { return _bounds.width(); }
 uint16_t       NatePixTable::Frame::height() const { return _bounds.height(); }
 Point          NatePixTable::Frame::center() const { return {-_bounds.left, -_bounds.top}; }
-const PixMap&  NatePixTable::Frame::pix_map() const { return _pix_map; }
 const Texture& NatePixTable::Frame::texture() const { return _texture; }
 
-void NatePixTable::Frame::build(pn::string_view name, int frame) {
-    _texture = sys.video->texture(pn::format("/sprites/{0}%{1}", name, frame), _pix_map, 1);
+const PixMap& NatePixTable::Frame::pix_map() const {
+    if (!_pix_map) {
+        // Discarded after upload; rebuild from the sprite resource the same way the constructor
+        // did.  This re-decodes the whole sheet for a single frame.
+        Rect        sprite = sprite_rect(Resource::sprite_data(_name).frames.at(_frame));
+        ArrayPixMap image  = Resource::sprite_image(_name);
+        std::unique_ptr<ArrayPixMap> pix(new ArrayPixMap(width(), height()));
+        pix->copy(image.view(sprite));
+        if (_hue != Hue::GRAY) {
+            ArrayPixMap overlay = Resource::sprite_overlay(_name);
+            load_overlay(*pix, overlay.view(sprite), _hue);
+        }
+        _pix_map = std::move(pix);
+    }
+    return *_pix_map;
+}
+
+void NatePixTable::Frame::build(PixResidency residency) {
+    _texture = sys.video->texture(pn::format("/sprites/{0}%{1}", _name, _frame), *_pix_map, 1);
+    if (residency == PixResidency::DISCARD) {
+        _pix_map.reset();
+    }
 }
 
 }  // namespace antares
@@ -18,9 +18,15 @@
 
 #include "drawing/sprite-handling.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <numeric>
+#include <thread>
+#include <vector>
 #include <sfz/sfz.hpp>
 
+#include "config/preferences.hpp"
 #include "data/resource.hpp"
 #include "drawing/color.hpp"
 #include "drawing/pix-table.hpp"
@@ -101,21 +107,122 @@ void ResetAllSprites() {
     }
 }
 
-void Pix::reset() {
-    _pix.clear();
-    _cursor.reset(new NatePixTable("gui/cursor", Hue::GRAY));
+static PixResidency pix_residency() {
+    return sys.prefs->discard_pixels() ? PixResidency::DISCARD : PixResidency::RESIDENT;
+}
+
+// Counts the texture, plus the CPU-side copy of the pixels if the table keeps one.
+static size_t pix_table_bytes(const NatePixTable& table) {
+    size_t bytes = 0;
+    for (size_t i = 0; i < table.size(); ++i) {
+        bytes += table.at(i).width() * table.at(i).height() * 4;
+    }
+    return (pix_residency() == PixResidency::RESIDENT) ? (2 * bytes) : bytes;
 }
 
-NatePixTable* Pix::add(pn::string_view name, Hue hue) {
-    NatePixTable* result = get(name, hue);
-    if (result) {
-        return result;
+// Decodes a list of sprite tables on background threads, in order, so that the main thread can
+// upload each one as soon as it is ready.
+class Pix::Loader {
+  public:
+    Loader(std::vector<Key> keys) : _keys(std::move(keys)), _results(_keys.size()) {
+        int threads = std::max<int>(
+                1, std::min<int>(_keys.size(), std::thread::hardware_concurrency()));
+        for (int i = 0; i < threads; ++i) {
+            _threads.emplace_back([this] { run(); });
+        }
+    }
+
+    // Abandons any tables that haven't started decoding yet.
+    ~Loader() {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _next = _keys.size();
+        }
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    size_t     size() const { return _keys.size(); }
+    const Key& key(size_t i) const { return _keys[i]; }
+
+    bool decoded(size_t begin, size_t end) const {
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (size_t i = begin; i < end; ++i) {
+            if (!_results[i].done) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Waits until table `i` is decoded, then returns it, or rethrows the error that decoding it
+    // hit.  Each table may be taken only once.
+    NatePixTable::Decoded take(size_t i) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _decoded.wait(lock, [this, i] { return _results[i].done; });
+        Result result = std::move(_results[i]);
+        if (result.error) {
+            std::rethrow_exception(result.error);
+        }
+        return std::move(*result.decoded);
     }
 
-    auto it = _pix.emplace(std::make_pair(name.copy(), hue), NatePixTable(name, hue)).first;
-    return &it->second;
+  private:
+    struct Result {
+        bool                                   done = false;
+        std::unique_ptr<NatePixTable::Decoded> decoded;
+        std::exception_ptr                     error;
+    };
+
+    void run() {
+        while (true) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_next == _keys.size()) {
+                return;
+            }
+            const Key& key = _keys[_next++];
+            lock.unlock();
+
+            Result result;
+            try {
+                result.decoded.reset(
+                        new NatePixTable::Decoded(NatePixTable::decode(key.first, key.second)));
+            } catch (...) {
+                result.error = std::current_exception();
+            }
+            result.done = true;
+
+            lock.lock();
+            _results[&key - _keys.data()] = std::move(result);
+            _decoded.notify_all();
+        }
+    }
+
+    const std::vector<Key>   _keys;
+    std::vector<Result>      _results;
+    size_t                   _next = 0;
+    mutable std::mutex       _mutex;
+    std::condition_variable  _decoded;
+    std::vector<std::thread> _threads;
+};
+
+Pix::Pix() {}
+Pix::~Pix() {}
+
+void Pix::reset() {
+    _loader.reset();
+    _requested.clear();
+    for (auto& kv : _pix) {
+        size_t bytes = pix_table_bytes(kv.second);
+        _cache.put({kv.first.first.copy(), kv.first.second}, std::move(kv.second), bytes);
+    }
+    _pix.clear();
+    _cursor.reset(new NatePixTable("gui/cursor", Hue::GRAY, pix_residency()));
 }
 
+void Pix::flush() { _cache.clear(); }
+
 NatePixTable* Pix::get(pn::string_view id, Hue hue) {
     auto it = _pix.find({id.copy(), hue});
     if (it != _pix.end()) {
@@ -126,6 +233,52 @@ NatePixTable* Pix::get(pn::string_view id, Hue hue) {
 
 const NatePixTable* Pix::cursor() { return _cursor.get(); }
 
+void Pix::request(pn::string_view id, Hue hue) {
+    if (get(id, hue)) {
+        return;
+    }
+    Key key{id.copy(), hue};
+    if (std::find(_requested.begin(), _requested.end(), key) != _requested.end()) {
+        return;
+    }
+    sfz::optional<NatePixTable> cached = _cache.take(key);
+    if (cached.has_value()) {
+        _pix.emplace(std::move(key), std::move(*cached));
+        return;
+    }
+    _requested.push_back(std::move(key));
+}
+
+void Pix::start_loading() {
+    _loader.reset(new Loader(std::move(_requested)));
+    _requested.clear();
+}
+
+bool Pix::ready(int part, int parts) const {
+    if (!_loader) {
+        return true;
+    }
+    return _loader->decoded(
+            _loader->size() * part / parts, _loader->size() * (part + 1) / parts);
+}
+
+void Pix::finish_loading(int part, int parts) {
+    if (!_loader) {
+        return;
+    }
+    size_t begin = _loader->size() * part / parts;
+    size_t end   = _loader->size() * (part + 1) / parts;
+    for (size_t i = begin; i < end; ++i) {
+        const Key& key = _loader->key(i);
+        _pix.emplace(
+                Key{key.first.copy(), key.second},
+                NatePixTable(_loader->take(i), pix_residency()));
+    }
+    if (end == _loader->size()) {
+        _loader.reset();
+    }
+}
+
 Handle<Sprite> AddSprite(
         Point where, NatePixTable* table, pn::string_view name, Hue hue, int16_t whichShape,
         Scale scale, sfz::optional<BaseObject::Icon> icon, BaseObject::Layer layer, Hue tiny_hue,
@@ -133,6 +286,7 @@ Handle<Sprite> AddSprite(
     for (Handle<Sprite> sprite : Sprite::all()) {
         if (sprite->table == NULL) {
             sprite->where      = where;
+            sprite->last_where = where;
             sprite->table      = table;
             sprite->whichShape = whichShape;
             sprite->scale      = scale;
@@ -165,43 +319,124 @@ Rect scale_sprite_rect(const NatePixTable::Frame& frame, Point where, Scale scal
     };
 }
 
+static ANTARES_GLOBAL Fixed tick_fraction    = Fixed::from_long(1);
+static ANTARES_GLOBAL Scale remembered_scale = MIN_SCALE;
+
+void remember_sprite_positions() {
+    remembered_scale = gAbsoluteScale;
+    for (auto sprite : Sprite::all()) {
+        sprite->last_where = sprite->where;
+    }
+}
+
+void set_tick_fraction(Fixed fraction) {
+    tick_fraction = (gAbsoluteScale == remembered_scale) ? fraction : Fixed::from_long(1);
+}
+
+Point tick_position(Point last, Point now) {
+    if (tick_fraction == Fixed::from_long(1)) {
+        return now;
+    }
+    const int64_t f = tick_fraction.val();
+    return Point(
+            last.h + static_cast<int32_t>((int64_t(now.h - last.h) * f) >> 8),
+            last.v + static_cast<int32_t>((int64_t(now.v - last.v) * f) >> 8));
+}
+
+namespace {
+
+// A sprite which overlaps the viewport, with the rect it will be drawn in.
+struct VisibleSprite {
+    Sprite* sprite;
+    Rect    rect;
+};
+
+// The sprites which overlap the viewport in the current frame, bucketed by layer.  Within each
+// bucket, sprites are in the order of Sprite::all(), which is the order they are drawn in.  The
+// vectors are kept between frames so that indexing doesn't allocate.
+const int kSpriteLayerCount = 3;
+ANTARES_GLOBAL std::vector<VisibleSprite> visible_sprites[kSpriteLayerCount];
+
+std::vector<VisibleSprite>* visible_layer(BaseObject::Layer layer) {
+    switch (layer) {
+        case BaseObject::Layer::BASES: return &visible_sprites[0];
+        case BaseObject::Layer::SHIPS: return &visible_sprites[1];
+        case BaseObject::Layer::SHOTS: return &visible_sprites[2];
+        default: return nullptr;
+    }
+}
+
+// Makes one pass over all sprites, and collects those which will be drawn inside `clip`.
+void index_visible_sprites(const Rect& clip) {
+    for (auto& layer : visible_sprites) {
+        layer.clear();
+    }
+
+    const bool tiny = (gAbsoluteScale < kBlipThreshhold);
+    for (auto aSprite : Sprite::all()) {
+        std::vector<VisibleSprite>* layer = visible_layer(aSprite->whichLayer);
+        if ((aSprite->table == NULL) || aSprite->killMe || !layer) {
+            continue;
+        }
+
+        Rect draw_rect;
+        if (!tiny) {
+            Scale trueScale                  = scale_by(aSprite->scale, gAbsoluteScale);
+            const NatePixTable::Frame& frame = aSprite->table->at(aSprite->whichShape);
+
+            Point where = tick_position(aSprite->last_where, aSprite->where);
+            draw_rect   = scale_sprite_rect(frame, where, trueScale);
+
+            if (aSprite->style == spriteColor) {
+                // Drawing a sprite with static has always advanced the global random seed.
+                // Keep doing so whether or not the sprite is visible, so that culling doesn't
+                // change anything else that depends on the seed.
+                Randomize(63);
+            }
+        } else {
+            int tinySize = aSprite->icon.size;
+            if (!tinySize || (aSprite->draw_tiny == NULL)) {
+                continue;
+            }
+            Point where = tick_position(aSprite->last_where, aSprite->where);
+            draw_rect   = Rect(-tinySize, -tinySize, tinySize, tinySize);
+            draw_rect.offset(where.h, where.v);
+        }
+
+        if (draw_rect.intersects(clip)) {
+            layer->push_back(VisibleSprite{aSprite.get(), draw_rect});
+        }
+    }
+}
+
+}  // namespace
+
+// Sprites which fall entirely outside the viewport are skipped.
 void draw_sprites() {
+    index_visible_sprites(viewport());
+
     if (gAbsoluteScale >= kBlipThreshhold) {
-        for (BaseObject::Layer layer :
-             {BaseObject::Layer::BASES, BaseObject::Layer::SHIPS, BaseObject::Layer::SHOTS}) {
-            for (auto aSprite : Sprite::all()) {
-                if ((aSprite->table != NULL) && !aSprite->killMe &&
-                    (aSprite->whichLayer == layer)) {
-                    Scale trueScale                  = scale_by(aSprite->scale, gAbsoluteScale);
-                    const NatePixTable::Frame& frame = aSprite->table->at(aSprite->whichShape);
-
-                    Rect draw_rect = scale_sprite_rect(frame, aSprite->where, trueScale);
-
-                    switch (aSprite->style) {
-                        case spriteNormal: frame.texture().draw(draw_rect); break;
-
-                        case spriteColor:
-                            Randomize(63);
-                            frame.texture().draw_static(
-                                    draw_rect, aSprite->styleColor, aSprite->styleData);
-                            break;
-                    }
+        for (const auto& layer : visible_sprites) {
+            for (const VisibleSprite& visible : layer) {
+                const Sprite&              aSprite = *visible.sprite;
+                const NatePixTable::Frame& frame   = aSprite.table->at(aSprite.whichShape);
+                switch (aSprite.style) {
+                    case spriteNormal: frame.texture().draw(visible.rect); break;
+
+                    case spriteColor:
+                        frame.texture().draw_static(
+                                visible.rect, aSprite.styleColor, aSprite.styleData);
+                        break;
                 }
             }
         }
     } else {
-        for (BaseObject::Layer layer :
-             {BaseObject::Layer::BASES, BaseObject::Layer::SHIPS, BaseObject::Layer::SHOTS}) {
-            for (auto aSprite : Sprite::all()) {
-                int tinySize = aSprite->icon.size;
-                if ((aSprite->table != NULL) && !aSprite->killMe && tinySize &&
-                    (aSprite->draw_tiny != NULL) && (aSprite->whichLayer == layer)) {
-                    Rect tiny_rect(-tinySize, -tinySize, tinySize, tinySize);
-                    tiny_rect.offset(aSprite->where.h, aSprite->where.v);
-                    aSprite->draw_tiny(
-                            tiny_rect, GetRGBTranslateColorShade(
-                                               aSprite->tinyColor.hue, aSprite->tinyColor.shade));
-                }
+        for (const auto& layer : visible_sprites) {
+            for (const VisibleSprite& visible : layer) {
+                const Sprite& aSprite = *visible.sprite;
+                aSprite.draw_tiny(
+                        visible.rect, GetRGBTranslateColorShade(
+                                              aSprite.tinyColor.hue, aSprite.tinyColor.shade));
             }
         }
     }
@@ -0,0 +1,76 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "drawing/sprite-handling.hpp"
+
+#include <gmock/gmock.h>
+
+#include "game/globals.hpp"
+#include "video/software-driver.hpp"
+
+using ::testing::Eq;
+
+namespace antares {
+namespace {
+
+std::vector<Rect> tiny_draws;
+
+void record_tiny(const Rect& rect, const RgbColor& color) { tiny_draws.push_back(rect); }
+
+Handle<Sprite> add_tiny_sprite(NatePixTable* table, Point where) {
+    Handle<Sprite> sprite = AddSprite(
+            where, table, "test", Hue::GRAY, 0, SCALE_SCALE,
+            BaseObject::Icon{BaseObject::Icon::Shape::SQUARE, 2}, BaseObject::Layer::SHIPS,
+            Hue::GRAY, 0);
+    sprite->draw_tiny = record_tiny;
+    return sprite;
+}
+
+using SpriteHandlingTest = testing::Test;
+
+// The viewport is the screen minus the side panels: (128, 0) to (608, 480).
+TEST_F(SpriteHandlingTest, CullsOutsideViewport) {
+    SoftwareVideoDriver video({640, 480}, sfz::nullopt);
+    NatePixTable        table(NatePixTable::Decoded{"test", Hue::GRAY, {}});
+    SpriteHandlingInit();
+    g.bottom_border = 0;
+    gAbsoluteScale  = kOneEighthScale;  // Draws blips, which don't need the table's frames.
+    set_tick_fraction(Fixed::from_long(1));
+
+    add_tiny_sprite(&table, {320, 360});  // Inside.
+    add_tiny_sprite(&table, {64, 240});   // Under the left panel.
+    add_tiny_sprite(&table, {624, 240});  // Under the right panel.
+    add_tiny_sprite(&table, {320, 600});  // Below the screen.
+    add_tiny_sprite(&table, {127, 100});  // Overlapping the left panel's edge.
+
+    tiny_draws.clear();
+    draw_sprites();
+    ASSERT_THAT(tiny_draws.size(), Eq(2));
+    EXPECT_THAT(tiny_draws[0], Eq(Rect(318, 358, 322, 362)));
+    EXPECT_THAT(tiny_draws[1], Eq(Rect(125, 98, 129, 102)));
+
+    // With a bottom border, as when a message is shown, sprites behind it are culled too.
+    g.bottom_border = 240;
+    tiny_draws.clear();
+    draw_sprites();
+    ASSERT_THAT(tiny_draws.size(), Eq(1));
+    EXPECT_THAT(tiny_draws[0], Eq(Rect(125, 98, 129, 102)));
+}
+
+}  // namespace
+}  // namespace antares
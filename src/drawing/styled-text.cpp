@@ -45,11 +45,7 @@ static int hex_digit(pn::rune r) {
     throw std::runtime_error(pn::format("{0} is not a valid hex digit", c).c_str());
 }
 
-template <typename container>
-static auto last(container& c) -> decltype(c.end()) {
-    auto it = c.end();
-    return (it == c.begin()) ? it : --it;
-}
+static bool is_continuation_byte(char c) { return (c & 0xC0) == 0x80; }
 
 StyledText::StyledText() : _wrap_metrics{sys.fonts.tactical} {}
 
@@ -58,29 +54,16 @@ StyledText::~StyledText() {}
 StyledText StyledText::plain(
         pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color) {
     StyledText t;
-    t._chars.reset(new std::map<pn::string::iterator, StyledChar>);
     t._text         = text.copy();
     t._wrap_metrics = metrics;
 
     for (auto it = t._text.begin(), end = t._text.end(); it != end; ++it) {
-        const auto r = *it;
-        switch (r.value()) {
-            case '\n':
-                t._chars->emplace(it, StyledChar(LINE_BREAK, 0, fore_color, back_color));
-                break;
-            case ' ':
-                t._chars->emplace(it, StyledChar(WORD_BREAK, 0, fore_color, back_color));
-                break;
-            case 0xA0:
-                t._chars->emplace(it, StyledChar(NO_BREAK, 0, fore_color, back_color));
-                break;
-            default: t._chars->emplace(it, StyledChar(NONE, 0, fore_color, back_color)); break;
-        }
+        t._chars.emplace_back(it.offset(), plain_special(*it), 0, fore_color, back_color);
     }
-    if (t._chars->empty() || (last(*t._chars)->second.special != LINE_BREAK)) {
-        t._chars->emplace(t._text.end(), StyledChar(LINE_BREAK, 0, fore_color, back_color));
+    if (t._chars.empty() || (t._chars.back().special != LINE_BREAK)) {
+        t._chars.emplace_back(t._text.size(), LINE_BREAK, 0, fore_color, back_color);
     }
-    t._until = t._chars->end();
+    t._until = t._chars.size();
 
     t.rewrap();
     return t;
@@ -89,7 +72,6 @@ StyledText StyledText::plain(
 StyledText StyledText::retro(
         pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color) {
     StyledText t;
-    t._chars.reset(new std::map<pn::string::iterator, StyledChar>);
     t._text         = text.copy();
     t._wrap_metrics = metrics;
 
@@ -105,25 +87,25 @@ StyledText StyledText::retro(
             case START:
                 switch (r.value()) {
                     case '\n':
-                        t._chars->emplace(it, StyledChar(LINE_BREAK, 0, fore_color, back_color));
+                        t._chars.emplace_back(it.offset(), LINE_BREAK, 0, fore_color, back_color);
                         break;
 
                     case '_':
                         // TODO(sfiera): replace use of "_" with e.g. "\_".
-                        t._chars->emplace(it, StyledChar(NO_BREAK, 0, fore_color, back_color));
+                        t._chars.emplace_back(it.offset(), NO_BREAK, 0, fore_color, back_color);
                         break;
 
                     case ' ':
-                        t._chars->emplace(it, StyledChar(WORD_BREAK, 0, fore_color, back_color));
+                        t._chars.emplace_back(it.offset(), WORD_BREAK, 0, fore_color, back_color);
                         break;
 
                     case '\\':
                         state = SLASH;
-                        t._chars->emplace(it, StyledChar(DELAY, 0, fore_color, back_color));
+                        t._chars.emplace_back(it.offset(), DELAY, 0, fore_color, back_color);
                         break;
 
                     default:
-                        t._chars->emplace(it, StyledChar(NONE, 0, fore_color, back_color));
+                        t._chars.emplace_back(it.offset(), NONE, 0, fore_color, back_color);
                         break;
                 }
                 break;
@@ -132,36 +114,36 @@ StyledText StyledText::retro(
                 switch (r.value()) {
                     case 'i':
                         std::swap(fore_color, back_color);
-                        t._chars->emplace(it, StyledChar(DELAY, 0, fore_color, back_color));
+                        t._chars.emplace_back(it.offset(), DELAY, 0, fore_color, back_color);
                         state = START;
                         break;
 
                     case 'r':
                         fore_color = original_fore_color;
                         back_color = original_back_color;
-                        t._chars->emplace(it, StyledChar(DELAY, 0, fore_color, back_color));
+                        t._chars.emplace_back(it.offset(), DELAY, 0, fore_color, back_color);
                         state = START;
                         break;
 
                     case 't':
-                        t._chars->erase(last(*t._chars));
-                        t._chars->emplace(it, StyledChar(TAB, 0, fore_color, back_color));
+                        t._chars.pop_back();
+                        t._chars.emplace_back(it.offset(), TAB, 0, fore_color, back_color);
                         state = START;
                         break;
 
                     case '\\':
-                        t._chars->erase(last(*t._chars));
-                        t._chars->emplace(it, StyledChar(NONE, 0, fore_color, back_color));
+                        t._chars.pop_back();
+                        t._chars.emplace_back(it.offset(), NONE, 0, fore_color, back_color);
                         state = START;
                         break;
 
                     case 'f':
-                        t._chars->erase(last(*t._chars));
+                        t._chars.pop_back();
                         state = FG1;
                         break;
 
                     case 'b':
-                        t._chars->erase(last(*t._chars));
+                        t._chars.pop_back();
                         state = BG1;
                         break;
 
@@ -191,10 +173,10 @@ StyledText StyledText::retro(
         throw std::runtime_error(pn::format("not enough input for special code.").c_str());
     }
 
-    if (t._chars->empty() || (last(*t._chars)->second.special != LINE_BREAK)) {
-        t._chars->emplace(t._text.end(), StyledChar(LINE_BREAK, 0, fore_color, back_color));
+    if (t._chars.empty() || (t._chars.back().special != LINE_BREAK)) {
+        t._chars.emplace_back(t._text.size(), LINE_BREAK, 0, fore_color, back_color);
     }
-    t._until = t._chars->end();
+    t._until = t._chars.size();
 
     t.rewrap();
     return t;
@@ -203,7 +185,6 @@ StyledText StyledText::retro(
 StyledText StyledText::interface(
         pn::string_view text, WrapMetrics metrics, RgbColor fore_color, RgbColor back_color) {
     StyledText t;
-    t._chars.reset(new std::map<pn::string::iterator, StyledChar>);
     t._text         = text.copy();
     t._wrap_metrics = metrics;
 
@@ -217,9 +198,9 @@ StyledText StyledText::interface(
         switch (state) {
             case START:
                 switch (r.value()) {
-                    case '\n': t._chars->emplace(it, StyledChar(LINE_BREAK, 0, f, b)); break;
-                    case ' ': t._chars->emplace(it, StyledChar(WORD_BREAK, 0, f, b)); break;
-                    default: t._chars->emplace(it, StyledChar(NONE, 0, f, b)); break;
+                    case '\n': t._chars.emplace_back(it.offset(), LINE_BREAK, 0, f, b); break;
+                    case ' ': t._chars.emplace_back(it.offset(), WORD_BREAK, 0, f, b); break;
+                    default: t._chars.emplace_back(it.offset(), NONE, 0, f, b); break;
                     case '^': state = CODE; break;
                 }
                 break;
@@ -250,24 +231,24 @@ StyledText StyledText::interface(
                 t._textures.push_back(Resource::texture(inline_pict.picture));
                 inline_pict.bounds = t._textures.back().size().as_rect();
                 t._inline_picts.emplace_back(std::move(inline_pict));
-                t._chars->emplace(it, StyledChar(PICTURE, t._inline_picts.size() - 1, f, b));
+                t._chars.emplace_back(it.offset(), PICTURE, t._inline_picts.size() - 1, f, b);
                 id.clear();
                 state = START;
                 break;
         }
     }
 
-    if (t._chars->empty() || (last(*t._chars)->second.special != LINE_BREAK)) {
-        t._chars->emplace(t._text.end(), StyledChar(LINE_BREAK, 0, f, b));
+    if (t._chars.empty() || (t._chars.back().special != LINE_BREAK)) {
+        t._chars.emplace_back(t._text.size(), LINE_BREAK, 0, f, b);
     }
-    t._until = t._chars->end();
+    t._until = t._chars.size();
 
     t.rewrap();
     return t;
 }
 
-bool StyledText::done() const { return _chars ? _until == _chars->end() : true; }
-void StyledText::hide() { _until = _chars ? _chars->begin() : decltype(_until){}; }
+bool StyledText::done() const { return _until == _chars.size(); }
+void StyledText::hide() { _until = 0; }
 void StyledText::advance() {
     if (!done()) {
         ++_until;
@@ -280,7 +261,82 @@ std::pair<int, int> StyledText::selection() const { return _selection; }
 void                StyledText::mark(int from, int to) { _mark = {from, to}; }
 std::pair<int, int> StyledText::mark() const { return _mark; }
 
-void StyledText::rewrap() {
+void StyledText::replace(int from, int to, pn::string_view text) {
+    if (!_inline_picts.empty()) {
+        throw std::runtime_error("can't edit text with inline pictures");
+    }
+
+    RgbColor fore_color = RgbColor::white();
+    RgbColor back_color = RgbColor::black();
+    if (!_chars.empty()) {
+        const StyledChar& style = _chars[std::min<int>(char_index(from), _chars.size() - 1)];
+        fore_color              = style.fore_color;
+        back_color              = style.back_color;
+    }
+
+    // Drop the implicit line break at the end; it's re-added below if still needed.
+    const bool shown = done();
+    if (!_chars.empty() && (_chars.back().offset == _text.size())) {
+        _chars.pop_back();
+    }
+
+    const int first = char_index(from);
+    const int last  = char_index(to);
+    const int delta = text.size() - (to - from);
+    _text.replace(from, to - from, text);
+    _chars.erase(_chars.begin() + first, _chars.begin() + last);
+    for (auto it = _chars.begin() + first; it != _chars.end(); ++it) {
+        it->offset += delta;
+    }
+
+    std::vector<StyledChar> inserted;
+    for (pn::string::iterator it{_text.data(), _text.size(), from},
+         end{_text.data(), _text.size(), from + static_cast<int>(text.size())};
+         it != end; ++it) {
+        inserted.emplace_back(it.offset(), plain_special(*it), 0, fore_color, back_color);
+    }
+    _chars.insert(_chars.begin() + first, inserted.begin(), inserted.end());
+
+    if (_chars.empty() || (_chars.back().special != LINE_BREAK)) {
+        _chars.emplace_back(_text.size(), LINE_BREAK, 0, fore_color, back_color);
+    }
+    _until = shown ? _chars.size() : std::min<int>(_until, _chars.size());
+
+    rewrap(first);
+}
+
+void StyledText::set_text(pn::string_view text) {
+    const pn::string_view old = _text;
+    const int             max = std::min(old.size(), text.size());
+
+    // Find the common prefix and suffix, without splitting any multi-byte runes.
+    int prefix = 0;
+    while ((prefix < max) && (old.data()[prefix] == text.data()[prefix])) {
+        ++prefix;
+    }
+    while ((prefix > 0) &&
+           (((prefix < old.size()) && is_continuation_byte(old.data()[prefix])) ||
+            ((prefix < text.size()) && is_continuation_byte(text.data()[prefix])))) {
+        --prefix;
+    }
+    if ((prefix == old.size()) && (prefix == text.size())) {
+        return;
+    }
+
+    int suffix = 0;
+    while ((suffix < (max - prefix)) &&
+           (old.data()[old.size() - suffix - 1] == text.data()[text.size() - suffix - 1])) {
+        ++suffix;
+    }
+    while ((suffix > 0) && is_continuation_byte(old.data()[old.size() - suffix])) {
+        --suffix;
+    }
+
+    pn::string middle = text.substr(prefix, text.size() - suffix - prefix).copy();
+    replace(prefix, old.size() - suffix, middle);
+}
+
+void StyledText::rewrap(int start) {
     if (_wrap_metrics.tab_width <= 0) {
         _wrap_metrics.tab_width = _wrap_metrics.width / 2;
     }
@@ -288,20 +344,36 @@ void StyledText::rewrap() {
     _auto_size = Size{0, 0};
     int h      = _wrap_metrics.side_margin;
     int v      = 0;
+    int i      = 0;
+
+    // Resume from the last paragraph starting at or before `start`. Everything before it is
+    // laid out independently of what follows.
+    auto para = std::upper_bound(
+            _paragraphs.begin(), _paragraphs.end(), start,
+            [](int index, const Paragraph& p) { return index < p.start; });
+    if (para != _paragraphs.begin()) {
+        --para;
+        i                = para->start;
+        v                = para->v;
+        _auto_size.width = para->auto_width;
+        ++para;
+    }
+    _paragraphs.erase(para, _paragraphs.end());
 
     const int line_height   = _wrap_metrics.font->height + _wrap_metrics.line_spacing;
     const int wrap_distance = _wrap_metrics.width - _wrap_metrics.side_margin;
+    const int restart       = i;
 
-    for (auto it = _chars->begin(), end = _chars->end(); it != end; ++it) {
-        StyledChar& ch = it->second;
+    for (; i < _chars.size(); ++i) {
+        StyledChar& ch = _chars[i];
         ch.bounds      = Rect{h, v, h, v + line_height};
         switch (ch.special) {
             case NONE:
             case NO_BREAK:
-                h += _wrap_metrics.font->char_width(*it->first);
+                h += _wrap_metrics.font->char_width(rune_at(i));
                 if (h >= wrap_distance) {
                     v += _wrap_metrics.font->height + _wrap_metrics.line_spacing;
-                    h = move_word_down(it, v);
+                    h = move_word_down(i, v);
                 }
                 _auto_size.width = std::max(_auto_size.width, h);
                 break;
@@ -314,9 +386,10 @@ void StyledText::rewrap() {
             case LINE_BREAK:
                 h = _wrap_metrics.side_margin;
                 v += _wrap_metrics.font->height + _wrap_metrics.line_spacing;
+                _paragraphs.push_back(Paragraph{i + 1, v, _auto_size.width});
                 break;
 
-            case WORD_BREAK: h += _wrap_metrics.font->char_width(*it->first); break;
+            case WORD_BREAK: h += _wrap_metrics.font->char_width(rune_at(i)); break;
 
             case PICTURE: {
                 inlinePictType* pict = &_inline_picts[ch.pict_index];
@@ -326,7 +399,7 @@ void StyledText::rewrap() {
                 h = _wrap_metrics.side_margin;
                 pict->bounds.offset(0, v - pict->bounds.top);
                 v += pict->bounds.height() + _wrap_metrics.line_spacing + 3;
-                if (next(it)->second.special == LINE_BREAK) {
+                if (_chars[i + 1].special == LINE_BREAK) {
                     v -= (_wrap_metrics.font->height + _wrap_metrics.line_spacing);
                 }
             } break;
@@ -336,10 +409,22 @@ void StyledText::rewrap() {
         ch.bounds.right = h;
     }
     _auto_size.height = v;
+
+    // `restart` begins a paragraph, so it also begins a line.
+    _lines.erase(
+            std::lower_bound(
+                    _lines.begin(), _lines.end(), restart,
+                    [](const Line& l, int index) { return l.start < index; }),
+            _lines.end());
+    for (i = restart; i < _chars.size(); ++i) {
+        if (_lines.empty() || (_chars[i].bounds.top != _lines.back().top)) {
+            _lines.push_back(Line{i, _chars[i].bounds.top});
+        }
+    }
 }
 
 bool StyledText::empty() const {
-    return _chars ? _chars->size() <= 1 : true;  // Always have \n at the end.
+    return _chars.size() <= 1;  // Always have \n at the end.
 }
 
 int StyledText::height() const { return _auto_size.height; }
@@ -354,11 +439,11 @@ void StyledText::draw(const Rect& bounds) const {
 
     {
         Rects rects;
-        for (auto it = _chars->begin(); it != _until; ++it) {
-            const StyledChar& ch = it->second;
+        for (int i = 0; i < _until; ++i) {
+            const StyledChar& ch = _chars[i];
             Rect              r  = ch.bounds;
             r.offset(bounds.left, bounds.top);
-            const RgbColor color = is_selected(it) ? ch.fore_color : ch.back_color;
+            const RgbColor color = is_selected(i) ? ch.fore_color : ch.back_color;
 
             switch (ch.special) {
                 case NONE:
@@ -386,9 +471,7 @@ void StyledText::draw(const Rect& bounds) const {
 
         if ((0 <= _selection.first) && (_selection.first == _selection.second) &&
             (_selection.second < _text.size())) {
-            auto it = _chars->lower_bound(
-                    pn::string::iterator{_text.data(), _text.size(), _selection.first});
-            const StyledChar& ch = it->second;
+            const StyledChar& ch = _chars[char_index(_selection.first)];
             Rect              r  = ch.bounds;
             r.offset(bounds.left, bounds.top);
             rects.fill(Rect{r.left, r.top, r.left + 1, r.bottom}, ch.fore_color);
@@ -398,18 +481,18 @@ void StyledText::draw(const Rect& bounds) const {
     {
         Quads quads(_wrap_metrics.font->texture);
 
-        for (auto it = _chars->begin(); it != _until; ++it) {
-            const StyledChar& ch = it->second;
+        for (int i = 0; i < _until; ++i) {
+            const StyledChar& ch = _chars[i];
             if (ch.special == NONE) {
-                RgbColor color = is_selected(it) ? ch.back_color : ch.fore_color;
+                RgbColor color = is_selected(i) ? ch.back_color : ch.fore_color;
                 Point    p = Point{ch.bounds.left + char_adjust.h, ch.bounds.top + char_adjust.v};
-                _wrap_metrics.font->draw(quads, p, *it->first, color);
+                _wrap_metrics.font->draw(quads, p, rune_at(i), color);
             }
         }
     }
 
-    for (auto it = _chars->begin(); it != _until; ++it) {
-        const StyledChar& ch     = it->second;
+    for (int i = 0; i < _until; ++i) {
+        const StyledChar& ch     = _chars[i];
         Point             corner = bounds.origin();
         if (ch.special == PICTURE) {
             const inlinePictType& inline_pict = _inline_picts[ch.pict_index];
@@ -422,11 +505,11 @@ void StyledText::draw(const Rect& bounds) const {
 }
 
 void StyledText::draw_cursor(const Rect& bounds, const RgbColor& color, bool ends) const {
-    if (done() || (!ends && ((_until == _chars->begin()) || (next(_until) == _chars->end())))) {
+    if (done() || (!ends && ((_until == 0) || (_until + 1 == _chars.size())))) {
         return;
     }
     const int         line_height = _wrap_metrics.font->height + _wrap_metrics.line_spacing;
-    const StyledChar& ch          = _until->second;
+    const StyledChar& ch          = _chars[_until];
     Rect              char_rect(0, 0, _wrap_metrics.font->logicalWidth, line_height);
     char_rect.offset(bounds.left + ch.bounds.left, bounds.top + ch.bounds.top);
     char_rect.clip_to(bounds);
@@ -481,24 +564,18 @@ static bool is_paragraph_end(
 
 bool StyledText::is_line_start(
         pn::string::iterator begin, pn::string::iterator end, pn::string::iterator it) const {
-    auto curr = _chars->lower_bound(it);
-    if (curr == _chars->begin()) {
-        return true;
-    }
-    auto prev =
-            _chars->lower_bound(pn::string::iterator{_text.data(), _text.size(), it.offset() - 1});
-    return (curr->second.bounds.top > prev->second.bounds.top);
+    const int i = char_index(it.offset());
+    return (i == _chars.size()) || (_lines[line_index(i)].start == i);
 }
 
 bool StyledText::is_line_end(
         pn::string::iterator begin, pn::string::iterator end, pn::string::iterator it) const {
-    auto curr = _chars->lower_bound(it);
-    if (curr == _chars->end()) {
+    const int i = char_index(it.offset());
+    if (i == _chars.size()) {
         return true;
     }
-    auto next =
-            _chars->lower_bound(pn::string::iterator{_text.data(), _text.size(), it.offset() + 1});
-    return (curr->second.bounds.top < next->second.bounds.top);
+    const int line = line_index(i) + 1;
+    return i + 1 == ((line < _lines.size()) ? _lines[line].start : _chars.size());
 }
 
 bool StyledText::is_start(
@@ -523,59 +600,22 @@ bool StyledText::is_end(
     }
 }
 
-pn::string::iterator StyledText::line_up(pn::string::iterator it) const {
-    auto          curr = _chars->lower_bound(it);
-    const int32_t h    = curr->second.bounds.left;
-    const int32_t v    = curr->second.bounds.top;
-    while ((curr != _chars->begin()) && (curr->second.bounds.top == v)) {
-        --curr;
-    }
-    if (curr == _chars->begin()) {
-        return curr->first;
-    }
-
-    const int32_t v2      = curr->second.bounds.top;
-    auto          closest = curr;
-    int32_t       diff    = std::abs(h - curr->second.bounds.left);
-    while ((curr != _chars->begin()) && (curr->second.bounds.top == v2)) {
-        int32_t diff2 = std::abs(h - curr->second.bounds.left);
-        if (diff2 <= diff) {
-            closest = curr;
-            diff    = diff2;
-        } else {
-            break;
-        }
-        --curr;
+int StyledText::line_up(int offset) const {
+    const int i    = std::min<int>(char_index(offset), _chars.size() - 1);
+    const int line = line_index(i);
+    if (line == 0) {
+        return _chars.front().offset;
     }
-    return closest->first;
+    return _chars[closest_in_line(line - 1, _chars[i].bounds.left, false)].offset;
 }
 
-pn::string::iterator StyledText::line_down(pn::string::iterator it) const {
-    auto          curr = _chars->lower_bound(it);
-    const int32_t h    = curr->second.bounds.left;
-    const int32_t v    = curr->second.bounds.top;
-    while ((curr != _chars->end()) && (curr->second.bounds.top == v)) {
-        ++curr;
-    }
-    if (curr == _chars->end()) {
-        --curr;
-        return curr->first;
-    }
-
-    const int32_t v2      = curr->second.bounds.top;
-    auto          closest = curr;
-    int32_t       diff    = std::abs(h - curr->second.bounds.left);
-    while ((curr != _chars->end()) && (curr->second.bounds.top == v2)) {
-        int32_t diff2 = std::abs(h - curr->second.bounds.left);
-        if (diff2 <= diff) {
-            closest = curr;
-            diff    = diff2;
-        } else {
-            break;
-        }
-        ++curr;
+int StyledText::line_down(int offset) const {
+    const int i    = std::min<int>(char_index(offset), _chars.size() - 1);
+    const int line = line_index(i);
+    if (line + 1 == _lines.size()) {
+        return _chars.back().offset;
     }
-    return closest->first;
+    return _chars[closest_in_line(line + 1, _chars[i].bounds.left, true)].offset;
 }
 
 int StyledText::offset(
@@ -590,8 +630,8 @@ int StyledText::offset(
     }
 
     switch (offset) {
-        case TextReceiver::PREV_SAME: return line_up(it).offset();
-        case TextReceiver::NEXT_SAME: return line_down(it).offset();
+        case TextReceiver::PREV_SAME: return line_up(origin);
+        case TextReceiver::NEXT_SAME: return line_down(origin);
 
         case TextReceiver::PREV_START:
             while (--it != begin) {
@@ -643,26 +683,25 @@ int StyledText::offset(
     }
 }
 
-int StyledText::move_word_down(std::map<pn::string::iterator, StyledChar>::iterator it, int v) {
-    const auto end = next(it);
-    while (true) {
-        StyledChar& ch = it->second;
-        switch (ch.special) {
+int StyledText::move_word_down(int index, int v) {
+    const int end = index + 1;
+    for (int i = index; i >= 0; --i) {
+        switch (_chars[i].special) {
             case LINE_BREAK:
             case PICTURE: return _wrap_metrics.side_margin;
 
             case WORD_BREAK:
             case TAB:
             case DELAY: {
-                ++it;
-                if (it->second.bounds.left <= _wrap_metrics.side_margin) {
+                ++i;
+                if (_chars[i].bounds.left <= _wrap_metrics.side_margin) {
                     return _wrap_metrics.side_margin;
                 }
 
                 int h = _wrap_metrics.side_margin;
-                for (; it != end; ++it) {
-                    it->second.bounds = Rect{Point{h, v}, it->second.bounds.size()};
-                    h += _wrap_metrics.font->char_width(*it->first);
+                for (; i != end; ++i) {
+                    _chars[i].bounds = Rect{Point{h, v}, _chars[i].bounds.size()};
+                    h += _wrap_metrics.font->char_width(rune_at(i));
                 }
                 return h;
             }
@@ -670,23 +709,81 @@ int StyledText::move_word_down(std::map<pn::string::iterator, StyledChar>::itera
             case NO_BREAK:
             case NONE: break;
         }
-
-        if (it == _chars->begin()) {
-            break;
-        }
-        --it;
     }
     return _wrap_metrics.side_margin;
 }
 
-bool StyledText::is_selected(std::map<pn::string::iterator, StyledChar>::const_iterator it) const {
-    return (_selection.first <= it->first.offset()) && (it->first.offset() < _selection.second);
+StyledText::SpecialChar StyledText::plain_special(pn::rune r) {
+    switch (r.value()) {
+        case '\n': return LINE_BREAK;
+        case ' ': return WORD_BREAK;
+        case 0xA0: return NO_BREAK;
+        default: return NONE;
+    }
+}
+
+bool StyledText::is_selected(int index) const {
+    const int offset = _chars[index].offset;
+    return (_selection.first <= offset) && (offset < _selection.second);
+}
+
+pn::rune StyledText::rune_at(int index) const {
+    return *pn::string::iterator{_text.data(), _text.size(), _chars[index].offset};
+}
+
+// Returns the index of the first char at or after byte `offset`.
+int StyledText::char_index(int offset) const {
+    return std::lower_bound(
+                   _chars.begin(), _chars.end(), offset,
+                   [](const StyledChar& ch, int offset) { return ch.offset < offset; }) -
+           _chars.begin();
+}
+
+// Returns the index of the line containing char `index`.
+int StyledText::line_index(int index) const {
+    return std::upper_bound(
+                   _lines.begin(), _lines.end(), index,
+                   [](int index, const Line& l) { return index < l.start; }) -
+           _lines.begin() - 1;
+}
+
+// Returns the index of the char in `line` horizontally closest to `h`.  Of several equally
+// close, returns the rightmost if `rightmost`, otherwise the leftmost.  Moving up picks the
+// leftmost and moving down the rightmost, as scanning towards the cursor always did.
+int StyledText::closest_in_line(int line, int h, bool rightmost) const {
+    const int  end   = (line + 1 < _lines.size()) ? _lines[line + 1].start : _chars.size();
+    const auto first = _chars.begin() + _lines[line].start;
+    const auto last  = _chars.begin() + end;
+
+    const auto before_h = [](const StyledChar& ch, int h) { return ch.bounds.left < h; };
+    const auto after_h  = [](int h, const StyledChar& ch) { return h < ch.bounds.left; };
+
+    // Positions only increase along a line, so both neighbors of `h` can be binary-searched.
+    // `next` is the first char at or after `h`, and the run of chars at the same position as
+    // `std::prev(next)` is the closest before it.
+    auto next = std::lower_bound(first, last, h, before_h);
+    if (next != first) {
+        const int  prev_h = std::prev(next)->bounds.left;
+        const int  before = h - prev_h;
+        const bool closer = (next == last) || (before < (next->bounds.left - h)) ||
+                            (!rightmost && (before == (next->bounds.left - h)));
+        if (closer) {
+            auto prev = rightmost ? std::prev(next)
+                                  : std::lower_bound(first, next, prev_h, before_h);
+            return prev - _chars.begin();
+        }
+    }
+    if (rightmost) {
+        next = std::prev(std::upper_bound(next, last, next->bounds.left, after_h));
+    }
+    return next - _chars.begin();
 }
 
 StyledText::StyledChar::StyledChar(
-        SpecialChar special, int pict_index, const RgbColor& fore_color,
+        int offset, SpecialChar special, int pict_index, const RgbColor& fore_color,
         const RgbColor& back_color)
-        : special{special},
+        : offset{offset},
+          special{special},
           pict_index{pict_index},
           fore_color{fore_color},
           back_color{back_color},
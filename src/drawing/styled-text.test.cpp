@@ -0,0 +1,112 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "drawing/styled-text.hpp"
+
+#include <gmock/gmock.h>
+
+#include "config/preferences.hpp"
+#include "game/sys.hpp"
+#include "video/text-driver.hpp"
+
+using ::testing::Eq;
+
+namespace antares {
+namespace {
+
+class StyledTextTest : public testing::Test {
+  public:
+    StyledTextTest() : video({640, 480}, sfz::nullopt) { sys_init(); }
+    TextVideoDriver video;
+    NullPrefsDriver prefs;
+
+    // Wraps narrowly enough that the paragraphs below take several lines each.
+    WrapMetrics metrics() const { return WrapMetrics{sys.fonts.tactical, 120}; }
+
+    // Checks that `text`, as edited, is laid out as if it were built from its text afresh.
+    void expect_same_layout(const StyledText& text) {
+        StyledText fresh = StyledText::plain(text.text(), metrics());
+        EXPECT_THAT(text.height(), Eq(fresh.height()));
+        EXPECT_THAT(text.auto_width(), Eq(fresh.auto_width()));
+        for (int i = 0; i <= text.text().size(); ++i) {
+            for (auto offset : {TextReceiver::PREV_START, TextReceiver::NEXT_END,
+                                TextReceiver::PREV_SAME, TextReceiver::NEXT_SAME}) {
+                EXPECT_THAT(
+                        text.offset(i, offset, TextReceiver::LINES),
+                        Eq(fresh.offset(i, offset, TextReceiver::LINES)))
+                        << "offset " << i << " in " << text.text().copy().c_str();
+            }
+        }
+    }
+};
+
+const char kParagraphs[] =
+        "The quick brown fox jumps over the lazy dog.\n"
+        "Pack my box with five dozen liquor jugs.\n"
+        "How vexingly quick daft zebras jump!";
+
+TEST_F(StyledTextTest, Typing) {
+    StyledText      text = StyledText::plain("", metrics());
+    pn::string_view typed{kParagraphs};
+    for (int i = 0; i < typed.size(); ++i) {
+        text.replace(i, i, typed.substr(i, 1));
+        expect_same_layout(text);
+    }
+    EXPECT_THAT(text.text(), Eq(typed));
+}
+
+TEST_F(StyledTextTest, Backspace) {
+    StyledText text = StyledText::plain(kParagraphs, metrics());
+    while (!text.text().empty()) {
+        const int end = text.text().size();
+        text.replace(end - 1, end, "");
+        expect_same_layout(text);
+    }
+}
+
+TEST_F(StyledTextTest, Replace) {
+    StyledText text = StyledText::plain(kParagraphs, metrics());
+
+    text.replace(4, 9, "slow and rather unremarkable");  // within the first paragraph.
+    expect_same_layout(text);
+
+    text.replace(40, 60, "");  // across the first line break.
+    expect_same_layout(text);
+
+    text.replace(10, 10, "\n");  // splitting a paragraph.
+    expect_same_layout(text);
+
+    text.replace(0, text.text().size(), "short");
+    expect_same_layout(text);
+}
+
+TEST_F(StyledTextTest, SetText) {
+    StyledText text = StyledText::plain(kParagraphs, metrics());
+
+    text.set_text("The quick brown fox jumps over the lazy dog.\nPack my box.");
+    expect_same_layout(text);
+
+    text.set_text("A quick brown fox.\nPack my box with five dozen liquor jugs, quickly.");
+    expect_same_layout(text);
+
+    text.set_text("");
+    expect_same_layout(text);
+}
+
+}  // namespace
+}  // namespace antares
@@ -55,7 +55,11 @@ Font::Font(
           logicalWidth(logical_width),
           height(height),
           ascent(ascent),
-          _glyphs(glyphs) {}
+          _glyphs(glyphs) {
+    for (int i = 0; i < kLatinGlyphs; ++i) {
+        _latin[i] = find_glyph(pn::rune(i));
+    }
+}
 
 Font font(pn::string_view name) {
     FontData d       = Resource::font(name);
@@ -65,27 +69,65 @@ Font font(pn::string_view name) {
 
 Font::~Font() {}
 
-Rect Font::glyph_rect(pn::rune rune) const {
+Rect Font::find_glyph(pn::rune rune) const {
     auto it = _glyphs.find(rune);
     if (it == _glyphs.end()) {
-        return glyph_rect(pn::rune{'?'});
+        return find_glyph(pn::rune{'?'});
     }
     return it->second;
 }
 
-void Font::draw(Point cursor, pn::string_view string, RgbColor color) const {
-    draw(Quads(texture), cursor, string, color);
+Rect Font::glyph_rect(pn::rune rune) const {
+    if (rune.value() < kLatinGlyphs) {
+        return _latin[rune.value()];
+    }
+    return find_glyph(rune);
 }
 
-void Font::draw(const Quads& quads, Point cursor, pn::string_view string, RgbColor color) const {
-    cursor.offset(0, -ascent);
-    for (pn::rune rune : string) {
+// FNV-1a over the UTF-8 bytes of `s`.
+static uint64_t glyph_run_key(pn::string_view s) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < s.size(); ++i) {
+        h = (h ^ static_cast<uint8_t>(s.data()[i])) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+const Font::GlyphRun& Font::glyph_run(pn::string_view s) const {
+    const uint64_t key = glyph_run_key(s);
+    auto           it  = _runs.find(key);
+    if ((it != _runs.end()) && (it->second.text == s)) {
+        return it->second;
+    }
+
+    if (_runs.size() >= kMaxGlyphRuns) {
+        _runs.clear();
+    }
+    GlyphRun& run = _runs[key];
+    run.text      = s.copy();
+    run.glyphs.clear();
+    Point cursor;
+    for (pn::rune rune : s) {
         auto glyph = glyph_rect(rune);
         if (rune.value() > ' ') {
-            quads.draw(Rect(cursor, glyph.size()), glyph, color);
+            run.glyphs.push_back(Glyph{Rect(cursor, glyph.size()), glyph});
         }
         cursor.offset(glyph.width(), 0);
     }
+    return run;
+}
+
+void Font::draw(Point cursor, pn::string_view string, RgbColor color) const {
+    draw(Quads(texture), cursor, string, color);
+}
+
+void Font::draw(const Quads& quads, Point cursor, pn::string_view string, RgbColor color) const {
+    cursor.offset(0, -ascent);
+    for (const Glyph& glyph : glyph_run(string).glyphs) {
+        Rect dest = glyph.dest;
+        dest.offset(cursor.h, cursor.v);
+        quads.draw(dest, glyph.source, color);
+    }
 }
 
 uint8_t Font::char_width(pn::rune mchar) const { return glyph_rect(mchar).width(); }
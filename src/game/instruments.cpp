@@ -20,10 +20,12 @@
 
 #include <algorithm>
 #include <sfz/sfz.hpp>
+#include <vector>
 
 #include "data/base-object.hpp"
 #include "drawing/color.hpp"
 #include "drawing/shapes.hpp"
+#include "drawing/sprite-handling.hpp"
 #include "game/admiral.hpp"
 #include "game/cursor.hpp"
 #include "game/globals.hpp"
@@ -124,10 +126,27 @@ struct barIndicatorType {
     Hue     hue;
 };
 
+// Fills for one region of the instrument panels.  They are retained between frames, and only
+// re-recorded when the values they were drawn from change.
+struct PanelRegion {
+    std::vector<int32_t>    key;
+    std::vector<FilledRect> rects;
+};
+
+enum {
+    kShieldRegion    = kShieldBar,
+    kEnergyRegion    = kEnergyBar,
+    kBatteryRegion   = kBatteryBar,
+    kBuildTimeRegion = 3,
+    kMoneyRegion     = 4,
+    kPanelRegionNum  = 5,
+};
+
 static ANTARES_GLOBAL unique_ptr<Scale[]> gScaleList;
 static ANTARES_GLOBAL int32_t gWhichScaleNum;
 static ANTARES_GLOBAL Rect view_range;
 static ANTARES_GLOBAL barIndicatorType gBarIndicator[kBarIndicatorNum];
+static ANTARES_GLOBAL PanelRegion gPanelRegions[kPanelRegionNum];
 
 struct SiteData {
     Point    a, b, c;
@@ -145,6 +164,21 @@ T clamp(T value, T min, T max) {
     }
 }
 
+// Re-records `region` with `draw`, unless it was last recorded with the same `key`.
+template <typename F>
+void retain(PanelRegion& region, std::vector<int32_t> key, F draw) {
+    if (key != region.key) {
+        region.key = std::move(key);
+        region.rects.clear();
+        draw(Rects{&region.rects});
+    }
+}
+
+void clear(PanelRegion& region) {
+    region.key.clear();
+    region.rects.clear();
+}
+
 }  // namespace
 
 static void draw_bar_indicator(int16_t, int32_t, int32_t);
@@ -182,6 +216,9 @@ void ResetInstruments() {
     for (i = 0; i < kBarIndicatorNum; i++) {
         gBarIndicator[i].thisValue = -1;
     }
+    for (PanelRegion& region : gPanelRegions) {
+        clear(region);
+    }
     // the shield bar
     gBarIndicator[kShieldBar].top = 359;
     gBarIndicator[kShieldBar].hue = Hue::SKY_BLUE;
@@ -373,88 +410,91 @@ void draw_radar() {
 static void draw_money() {
     auto&      admiral = g.admiral;
     const Cash cash    = clamp(admiral->cash(), Cash{Fixed::zero()}, kMaxMoneyValue);
-    gBarIndicator[kFineMoneyBar].thisValue =
+    const int  fine =
             mFixedToLong((cash.amount % kFineMoneyBarMod.amount) / kFineMoneyBarValue.amount);
     const int price = mFixedToLong(
             MiniComputerGetPriceOfCurrentSelection().amount / kFineMoneyBarValue.amount);
-
-    Rect box(0, 0, kFineMoneyBarWidth, kFineMoneyBarHeight - 1);
-    box.offset(
-            kFineMoneyLeft + kFineMoneyHBuffer + play_screen().right,
-            kFineMoneyTop + instrument_top() + kFineMoneyVBuffer);
-
-    // First section of the money bar: when we can afford the current selection, displays the
-    // money which will remain after it is purchased.  When we cannot, displays the money we
-    // currently have.
-    int      first_threshold;
-    RgbColor first_color_major;
-    RgbColor first_color_minor;
-
-    // Second section of the money bar: when we can afford the current selection, displays the
-    // amount which will be deducted after it is purchased.  When we cannot, displays the
-    // amount of additional money which we need to amass before it can be purchased.
-    int      second_threshold;
-    RgbColor second_color_major;
-    RgbColor second_color_minor;
-
-    // Third section: money we don't have and don't need for the current selection.
-    RgbColor third_color = GetRGBTranslateColorShade(kFineMoneyColor, VERY_DARK);
-
-    if (gBarIndicator[kFineMoneyBar].thisValue < price) {
-        first_color_major  = GetRGBTranslateColorShade(kFineMoneyColor, LIGHTEST);
-        first_color_minor  = GetRGBTranslateColorShade(kFineMoneyColor, LIGHT);
-        second_color_major = GetRGBTranslateColorShade(kFineMoneyNeedColor, MEDIUM);
-        second_color_minor = GetRGBTranslateColorShade(kFineMoneyNeedColor, DARK);
-        first_threshold    = gBarIndicator[kFineMoneyBar].thisValue;
-        second_threshold   = price;
-    } else {
-        first_color_major  = GetRGBTranslateColorShade(kFineMoneyColor, LIGHTEST);
-        first_color_minor  = GetRGBTranslateColorShade(kFineMoneyColor, LIGHT);
-        second_color_major = GetRGBTranslateColorShade(kFineMoneyUseColor, LIGHTEST);
-        second_color_minor = GetRGBTranslateColorShade(kFineMoneyUseColor, LIGHT);
-        first_threshold    = gBarIndicator[kFineMoneyBar].thisValue - price;
-        second_threshold   = gBarIndicator[kFineMoneyBar].thisValue;
-    }
-
-    Rects rects;
-    for (int i = 0; i < kFineMoneyBarNum; ++i) {
-        if (i < first_threshold) {
-            if ((i % 5) != 0) {
-                rects.fill(box, first_color_minor);
-            } else {
-                rects.fill(box, first_color_major);
-            }
-        } else if (i < second_threshold) {
-            if ((i % 5) != 0) {
-                rects.fill(box, second_color_minor);
-            } else {
-                rects.fill(box, second_color_major);
-            }
-        } else {
-            rects.fill(box, third_color);
-        }
-        box.offset(0, kFineMoneyBarHeight);
-    }
-    gBarIndicator[kFineMoneyBar].thisValue = second_threshold;
-
-    barIndicatorType* gross = gBarIndicator + kGrossMoneyBar;
-    gross->thisValue        = mFixedToLong(admiral->cash().amount / kGrossMoneyBarValue.amount);
-
-    box = Rect(0, 0, kGrossMoneyBarWidth, kGrossMoneyBarHeight - 1);
-    box.offset(
-            play_screen().right + kGrossMoneyLeft + kGrossMoneyHBuffer,
-            kGrossMoneyTop + instrument_top() + kGrossMoneyVBuffer);
-
-    const RgbColor light = GetRGBTranslateColorShade(kGrossMoneyColor, LIGHTEST);
-    const RgbColor dark  = GetRGBTranslateColorShade(kGrossMoneyColor, VERY_DARK);
-    for (int i = 0; i < kGrossMoneyBarNum; ++i) {
-        if (i < gross->thisValue) {
-            rects.fill(box, light);
-        } else {
-            rects.fill(box, dark);
-        }
-        box.offset(0, kGrossMoneyBarHeight);
-    }
+    const int gross = mFixedToLong(admiral->cash().amount / kGrossMoneyBarValue.amount);
+    gBarIndicator[kFineMoneyBar].thisValue  = (fine < price) ? price : fine;
+    gBarIndicator[kGrossMoneyBar].thisValue = gross;
+
+    retain(gPanelRegions[kMoneyRegion],
+           {fine, price, gross, instrument_top(), play_screen().right},
+           [fine, price, gross](const Rects& rects) {
+               Rect box(0, 0, kFineMoneyBarWidth, kFineMoneyBarHeight - 1);
+               box.offset(
+                       kFineMoneyLeft + kFineMoneyHBuffer + play_screen().right,
+                       kFineMoneyTop + instrument_top() + kFineMoneyVBuffer);
+
+               // First section of the money bar: when we can afford the current selection,
+               // displays the money which will remain after it is purchased.  When we cannot,
+               // displays the money we currently have.
+               int      first_threshold;
+               RgbColor first_color_major;
+               RgbColor first_color_minor;
+
+               // Second section of the money bar: when we can afford the current selection,
+               // displays the amount which will be deducted after it is purchased.  When we
+               // cannot, displays the amount of additional money which we need to amass before
+               // it can be purchased.
+               int      second_threshold;
+               RgbColor second_color_major;
+               RgbColor second_color_minor;
+
+               // Third section: money we don't have and don't need for the current selection.
+               RgbColor third_color = GetRGBTranslateColorShade(kFineMoneyColor, VERY_DARK);
+
+               if (fine < price) {
+                   first_color_major  = GetRGBTranslateColorShade(kFineMoneyColor, LIGHTEST);
+                   first_color_minor  = GetRGBTranslateColorShade(kFineMoneyColor, LIGHT);
+                   second_color_major = GetRGBTranslateColorShade(kFineMoneyNeedColor, MEDIUM);
+                   second_color_minor = GetRGBTranslateColorShade(kFineMoneyNeedColor, DARK);
+                   first_threshold    = fine;
+                   second_threshold   = price;
+               } else {
+                   first_color_major  = GetRGBTranslateColorShade(kFineMoneyColor, LIGHTEST);
+                   first_color_minor  = GetRGBTranslateColorShade(kFineMoneyColor, LIGHT);
+                   second_color_major = GetRGBTranslateColorShade(kFineMoneyUseColor, LIGHTEST);
+                   second_color_minor = GetRGBTranslateColorShade(kFineMoneyUseColor, LIGHT);
+                   first_threshold    = fine - price;
+                   second_threshold   = fine;
+               }
+
+               for (int i = 0; i < kFineMoneyBarNum; ++i) {
+                   if (i < first_threshold) {
+                       if ((i % 5) != 0) {
+                           rects.fill(box, first_color_minor);
+                       } else {
+                           rects.fill(box, first_color_major);
+                       }
+                   } else if (i < second_threshold) {
+                       if ((i % 5) != 0) {
+                           rects.fill(box, second_color_minor);
+                       } else {
+                           rects.fill(box, second_color_major);
+                       }
+                   } else {
+                       rects.fill(box, third_color);
+                   }
+                   box.offset(0, kFineMoneyBarHeight);
+               }
+
+               box = Rect(0, 0, kGrossMoneyBarWidth, kGrossMoneyBarHeight - 1);
+               box.offset(
+                       play_screen().right + kGrossMoneyLeft + kGrossMoneyHBuffer,
+                       kGrossMoneyTop + instrument_top() + kGrossMoneyVBuffer);
+
+               const RgbColor light = GetRGBTranslateColorShade(kGrossMoneyColor, LIGHTEST);
+               const RgbColor dark  = GetRGBTranslateColorShade(kGrossMoneyColor, VERY_DARK);
+               for (int i = 0; i < kGrossMoneyBarNum; ++i) {
+                   if (i < gross) {
+                       rects.fill(box, light);
+                   } else {
+                       rects.fill(box, dark);
+                   }
+                   box.offset(0, kGrossMoneyBarHeight);
+               }
+           });
 }
 
 void set_up_instruments() {
@@ -487,17 +527,28 @@ void draw_instruments() {
         draw_bar_indicator(kShieldBar, g.ship->health(), g.ship->max_health());
         draw_bar_indicator(kEnergyBar, g.ship->energy(), g.ship->max_energy());
         draw_bar_indicator(kBatteryBar, g.ship->battery(), g.ship->max_battery());
+    } else {
+        clear(gPanelRegions[kShieldRegion]);
+        clear(gPanelRegions[kEnergyRegion]);
+        clear(gPanelRegions[kBatteryRegion]);
     }
 
     draw_build_time_bar();
     draw_money();
+    {
+        Rects rects;
+        for (const PanelRegion& region : gPanelRegions) {
+            rects.fill(region.rects);
+        }
+    }
     draw_radar();
     draw_mini_screen();
 }
 
 void EraseSite() {}
 
-static void update_triangle(SiteData& site, int32_t direction, int32_t distance, int32_t size) {
+static void update_triangle(
+        SiteData& site, Point where, int32_t direction, int32_t distance, int32_t size) {
     int   count;
     Fixed fa, fb, fc;
     GetRotPoint(&fa, &fb, direction);
@@ -507,7 +558,7 @@ static void update_triangle(SiteData& site, int32_t direction, int32_t distance,
     fb = (fc * fb);
 
     Point a(mFixedToLong(fa), mFixedToLong(fb));
-    a.offset(g.ship->sprite->where.h, g.ship->sprite->where.v);
+    a.offset(where.h, where.v);
     site.a = a;
 
     count = direction;
@@ -547,7 +598,8 @@ void draw_site(const PlayerShip& player) {
     SiteData site;
     site.light = GetRGBTranslateColorShade(Hue::PALE_GREEN, MEDIUM);
     site.dark  = GetRGBTranslateColorShade(Hue::PALE_GREEN, DARKER + kSlightlyDarkerColor);
-    update_triangle(site, g.ship->direction, kSiteDistance, kSiteSize);
+    const Point where = tick_position(g.ship->sprite->last_where, g.ship->sprite->where);
+    update_triangle(site, where, g.ship->direction, kSiteDistance, kSiteSize);
 
     Lines lines;
     lines.draw(site.a, site.b, site.light);
@@ -564,7 +616,8 @@ void draw_site(const PlayerShip& player) {
     } else {
         return;
     }
-    update_triangle(control, player.control_direction(), kSiteDistance - 3, kSiteSize - 6);
+    update_triangle(
+            control, where, player.control_direction(), kSiteDistance - 3, kSiteSize - 6);
     lines.draw(control.a, control.b, control.light);
     lines.draw(control.a, control.c, control.light);
     lines.draw(control.b, control.c, control.dark);
@@ -635,7 +688,6 @@ void draw_arbitrary_sector_lines(
 }
 
 static void draw_bar_indicator(int16_t which, int32_t value, int32_t max) {
-    Rects rects;
     if (value > max) {
         value = max;
     }
@@ -652,27 +704,31 @@ static void draw_bar_indicator(int16_t which, int32_t value, int32_t max) {
         graphicValue = 0;
     }
 
-    Hue  hue = gBarIndicator[which].hue;
-    Rect bar(0, 0, kBarIndicatorWidth, kBarIndicatorHeight);
-    bar.offset(
-            kBarIndicatorLeft + play_screen().right, gBarIndicator[which].top + instrument_top());
-    if (graphicValue < kBarIndicatorHeight) {
-        Rect top_bar               = bar;
-        top_bar.bottom             = top_bar.bottom - graphicValue;
-        const RgbColor fill_color  = GetRGBTranslateColorShade(hue, DARK);
-        const RgbColor light_color = GetRGBTranslateColorShade(hue, MEDIUM);
-        const RgbColor dark_color  = GetRGBTranslateColorShade(hue, DARKER);
-        draw_shaded_rect(rects, top_bar, fill_color, light_color, dark_color);
-    }
-
-    if (graphicValue > 0) {
-        Rect bottom_bar            = bar;
-        bottom_bar.top             = bottom_bar.bottom - graphicValue;
-        const RgbColor fill_color  = GetRGBTranslateColorShade(hue, LIGHTER);
-        const RgbColor light_color = GetRGBTranslateColorShade(hue, LIGHTEST);
-        const RgbColor dark_color  = GetRGBTranslateColorShade(hue, MEDIUM);
-        draw_shaded_rect(rects, bottom_bar, fill_color, light_color, dark_color);
-    }
+    retain(gPanelRegions[which], {graphicValue, instrument_top(), play_screen().right},
+           [which, graphicValue](const Rects& rects) {
+               Hue  hue = gBarIndicator[which].hue;
+               Rect bar(0, 0, kBarIndicatorWidth, kBarIndicatorHeight);
+               bar.offset(
+                       kBarIndicatorLeft + play_screen().right,
+                       gBarIndicator[which].top + instrument_top());
+               if (graphicValue < kBarIndicatorHeight) {
+                   Rect top_bar               = bar;
+                   top_bar.bottom             = top_bar.bottom - graphicValue;
+                   const RgbColor fill_color  = GetRGBTranslateColorShade(hue, DARK);
+                   const RgbColor light_color = GetRGBTranslateColorShade(hue, MEDIUM);
+                   const RgbColor dark_color  = GetRGBTranslateColorShade(hue, DARKER);
+                   draw_shaded_rect(rects, top_bar, fill_color, light_color, dark_color);
+               }
+
+               if (graphicValue > 0) {
+                   Rect bottom_bar            = bar;
+                   bottom_bar.top             = bottom_bar.bottom - graphicValue;
+                   const RgbColor fill_color  = GetRGBTranslateColorShade(hue, LIGHTER);
+                   const RgbColor light_color = GetRGBTranslateColorShade(hue, LIGHTEST);
+                   const RgbColor dark_color  = GetRGBTranslateColorShade(hue, MEDIUM);
+                   draw_shaded_rect(rects, bottom_bar, fill_color, light_color, dark_color);
+               }
+           });
 
     gBarIndicator[which].thisValue = value;
 }
@@ -680,6 +736,7 @@ static void draw_bar_indicator(int16_t which, int32_t value, int32_t max) {
 void draw_build_time_bar() {
     auto build_at = GetAdmiralBuildAtObject(g.admiral);
     if (!build_at.get()) {
+        clear(gPanelRegions[kBuildTimeRegion]);
         return;
     }
 
@@ -687,30 +744,31 @@ void draw_build_time_bar() {
     if (build_at->totalBuildTime > ticks(0)) {
         value = build_at->buildTime * kMiniBuildTimeHeight / build_at->totalBuildTime;
     }
-
-    Rects rects;
     value = kMiniBuildTimeHeight - value;
 
-    const Rect clip = mini_build_time_rect();
-
-    {
-        const RgbColor color = GetRGBTranslateColorShade(Hue::PALE_PURPLE, MEDIUM);
-        draw_vbracket(rects, clip, color);
-    }
-
-    Rect bar = clip;
-    bar.inset(2, 2);
-
-    {
-        const RgbColor color = GetRGBTranslateColorShade(Hue::PALE_PURPLE, DARK);
-        rects.fill(bar, color);
-    }
-
-    if (value > 0) {
-        bar.top += value;
-        const RgbColor color = GetRGBTranslateColorShade(Hue::PALE_PURPLE, LIGHT);
-        rects.fill(bar, color);
-    }
+    retain(gPanelRegions[kBuildTimeRegion], {value, instrument_top(), play_screen().right},
+           [value](const Rects& rects) {
+               const Rect clip = mini_build_time_rect();
+
+               {
+                   const RgbColor color = GetRGBTranslateColorShade(Hue::PALE_PURPLE, MEDIUM);
+                   draw_vbracket(rects, clip, color);
+               }
+
+               Rect bar = clip;
+               bar.inset(2, 2);
+
+               {
+                   const RgbColor color = GetRGBTranslateColorShade(Hue::PALE_PURPLE, DARK);
+                   rects.fill(bar, color);
+               }
+
+               if (value > 0) {
+                   bar.top += value;
+                   const RgbColor color = GetRGBTranslateColorShade(Hue::PALE_PURPLE, LIGHT);
+                   rects.fill(bar, color);
+               }
+           });
 }
 
 }  // namespace antares
@@ -22,6 +22,7 @@
 
 #include "drawing/color.hpp"
 #include "drawing/pix-map.hpp"
+#include "drawing/sprite-handling.hpp"
 #include "drawing/text.hpp"
 #include "game/admiral.hpp"
 #include "game/cursor.hpp"
@@ -104,6 +105,7 @@ Handle<Label> Label::add(
 
 void Label::remove() {
     thisRect = Rect(0, 0, -1, -1);
+    lastRect = Rect(0, 0, -1, -1);
     _text    = StyledText{};
     active   = false;
     killMe   = false;
@@ -123,14 +125,25 @@ void Label::draw() {
             (label->thisRect.width() <= 0) || (label->thisRect.height() <= 0)) {
             continue;
         }
+        // A label that was resized or clipped since the last tick jumps to its new rect.
+        if (label->lastRect.size() == rect.size()) {
+            Point at = tick_position(label->lastRect.origin(), rect.origin());
+            rect.offset(at.h - rect.left, at.v - rect.top);
+        }
         const RgbColor dark = GetRGBTranslateColorShade(label->hue, VERY_DARK);
-        sys.video->dither_rect(label->thisRect, dark);
+        sys.video->dither_rect(rect, dark);
         rect.offset(kLabelInnerSpace, kLabelInnerSpace);
 
         label->_text.draw(rect);
     }
 }
 
+void Label::remember_positions() {
+    for (auto label : all()) {
+        label->lastRect = label->thisRect;
+    }
+}
+
 void Label::update_contents(ticks units_done) {
     Rect clip = viewport();
     for (auto label : all()) {
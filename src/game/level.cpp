@@ -93,7 +93,7 @@ void AddBaseObjectMedia(
     }
     for (int i = 0; i < 16; ++i) {
         if (colors[i] && sprite_resource(*base).has_value()) {
-            sys.pix.add(*sprite_resource(*base), Hue(i));
+            sys.pix.request(*sprite_resource(*base), Hue(i));
         }
     }
 
@@ -193,8 +193,7 @@ LoadState start_construct_level(const Level& level) {
     Admiral::reset();
     ResetAllDestObjectData();
     ResetMotionGlobals();
-    plug.races.clear();
-    plug.objects.clear();
+    unload_objects();
     gAbsoluteScale = kTimesTwoScale;
     g.sync         = 0;
 
@@ -231,7 +230,7 @@ LoadState start_construct_level(const Level& level) {
     sys.sound.reset();
 
     LoadState s;
-    s.max = Initial::all().size() * 3L + 1 +
+    s.max = Initial::all().size() * 4L + 1 +
             g.level->base.start_time.value_or(secs(0))
                     .count();  // for each run through the initial num
 
@@ -269,9 +268,9 @@ static void load_initial(Handle<const Initial> initial, std::bitset<16> all_colo
     // make sure we're not overriding the sprite
     if (initial->override_.sprite.has_value()) {
         if (baseObject->attributes & kCanThink) {
-            sys.pix.add(*initial->override_.sprite, GetAdmiralColor(owner));
+            sys.pix.request(*initial->override_.sprite, GetAdmiralColor(owner));
         } else {
-            sys.pix.add(*initial->override_.sprite, Hue::GRAY);
+            sys.pix.request(*initial->override_.sprite, Hue::GRAY);
         }
     }
 
@@ -322,26 +321,31 @@ void construct_level(LoadState* state) {
         }
     }
 
-    if (step == 0) {
-        load_blessed_objects(all_colors);
-        load_initial(Handle<const Initial>(step), all_colors);
-    } else if (step < Initial::all().size()) {
+    if (step < Initial::all().size()) {
+        if (step == 0) {
+            load_blessed_objects(all_colors);
+        }
         load_initial(Handle<const Initial>(step), all_colors);
-    } else if (step == Initial::all().size()) {
-        // add media for all condition actions
-        step -= Initial::all().size();
-        for (auto c : Condition::all()) {
-            load_condition(c, all_colors);
+        if (step == (Initial::all().size() - 1)) {
+            // add media for all condition actions
+            for (auto c : Condition::all()) {
+                load_condition(c, all_colors);
+            }
+            sys.pix.start_loading();
         }
-        create_initial(Handle<const Initial>(step));
     } else if (step < (2 * Initial::all().size())) {
+        // the requested sprites are decoded in the background, and uploaded in as many steps
+        // as there are initials, so that the progress bar keeps moving.
         step -= Initial::all().size();
-        create_initial(Handle<const Initial>(step));
+        sys.pix.finish_loading(step, Initial::all().size());
     } else if (step < (3 * Initial::all().size())) {
-        // double back and set up any defined initial destinations
         step -= (2 * Initial::all().size());
+        create_initial(Handle<const Initial>(step));
+    } else if (step < (4 * Initial::all().size())) {
+        // double back and set up any defined initial destinations
+        step -= (3 * Initial::all().size());
         set_initial_destination(Handle<const Initial>(step), false);
-    } else if (step == (3 * Initial::all().size())) {
+    } else if (step == (4 * Initial::all().size())) {
         RecalcAllAdmiralBuildData();  // set up all the admiral's destination objects
         Messages::clear();
         g.time = game_ticks(-g.level->base.start_time.value_or(secs(0)));
@@ -355,6 +359,14 @@ void construct_level(LoadState* state) {
     return;
 }
 
+bool construct_level_ready(const LoadState& state) {
+    int32_t step = state.step - Initial::all().size();
+    if ((step < 0) || (step >= Initial::all().size())) {
+        return true;
+    }
+    return sys.pix.ready(step, Initial::all().size());
+}
+
 void DeclareWinner(Handle<Admiral> whichPlayer, const Level* nextLevel, pn::string_view text) {
     if (!whichPlayer.get()) {
         // if there's no winner, we want to exit immediately
@@ -111,6 +111,9 @@ class GamePlay : public Card {
     virtual void gamepad_stick(const GamepadStickEvent& event);
 
   private:
+    bool  interpolating() const;
+    Fixed tick_fraction() const;
+
     enum State {
         PLAYING,
         PAUSED,
@@ -138,6 +141,12 @@ class GamePlay : public Card {
     // clock.
     wall_time _real_time;
 
+    // When the frame cap allows drawing more often than once per tick, frames are drawn every
+    // `_frame_interval` in between ticks (or as often as possible, with no cap), with moving
+    // things interpolated between their positions at the last two ticks.
+    const usecs _frame_interval;
+    wall_time   _next_frame;
+
     InputSource* _input_source;
 };
 
@@ -232,6 +241,10 @@ GamePlay::GamePlay(bool replay, InputSource* input, GameResult* game_result)
           _fast_motion(false),
           _player_paused(false),
           _real_time(now()),
+          _frame_interval(
+                  (sys.prefs->frame_cap() > 0) ? usecs(1000000 / sys.prefs->frame_cap())
+                                               : usecs(0)),
+          _next_frame(now()),
           _input_source(input) {}
 
 static const usecs kSwitchAfter = usecs(1000000 / 3);  // TODO(sfiera): ticks(20)
@@ -278,7 +291,7 @@ class PauseScreen : public Card {
     virtual void fire_timer() { show_hide(); }
 
     virtual void draw() const {
-        next()->draw();
+        draw_next();
         if (asleep() || _visible) {
             const RgbColor& light_green = GetRGBTranslateColorShade(Hue::GREEN, LIGHTER);
             const RgbColor& dark_green  = GetRGBTranslateColorShade(Hue::GREEN, DARKER);
@@ -387,6 +400,7 @@ void GamePlay::become_front() {
 void GamePlay::resign_front() { minicomputer_cancel(); }
 
 void GamePlay::draw() const {
+    set_tick_fraction(tick_fraction());
     globals()->starfield.draw();
     if (_should_draw_sector_lines) {
         draw_sector_lines();
@@ -410,12 +424,30 @@ void GamePlay::draw() const {
 bool GamePlay::next_timer(wall_time& time) {
     if (_state == PLAYING) {
         time = _next_timer;
+        if (interpolating()) {
+            time = std::min(time, _next_frame);
+        }
         return true;
     }
     return false;
 }
 
+bool GamePlay::interpolating() const {
+    return sys.video->real_time() && (_frame_interval < kMinorTick);
+}
+
+Fixed GamePlay::tick_fraction() const {
+    if (!interpolating() || (_state != PLAYING) || _fast_motion) {
+        return Fixed::from_long(1);
+    }
+    const int64_t since_tick = usecs(now() - _real_time).count();
+    const int64_t tick       = usecs(kMinorTick).count();
+    return Fixed::from_val(std::min<int64_t>(std::max<int64_t>(0, since_tick * 256 / tick), 256));
+}
+
 void GamePlay::fire_timer() {
+    _next_frame = now() + _frame_interval;
+
     while (_next_timer < now()) {
         _next_timer = _next_timer + kMinorTick;
     }
@@ -445,6 +477,10 @@ void GamePlay::fire_timer() {
     }
 
     while (unitsPassed > ticks(0)) {
+        remember_sprite_positions();
+        Label::remember_positions();
+        Vectors::remember_positions();
+
         ticks unitsToDo   = unitsPassed;
         ticks minor_ticks = g.time.time_since_epoch() % kMajorTick;
         if (minor_ticks + unitsToDo > kMajorTick) {
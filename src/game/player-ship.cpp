@@ -1001,9 +1001,13 @@ void PlayerShip::MessageText::stop_editing() {
 }
 
 void PlayerShip::MessageText::update(pn::string_view text, range<int> selection, range<int> mark) {
-    g.send_label->text() = StyledText::plain(
-            text, {sys.fonts.tactical, viewport().width() / 2},
-            GetRGBTranslateColorShade(Hue::GREEN, LIGHTEST));
+    if (g.send_label->text().empty()) {
+        g.send_label->text() = StyledText::plain(
+                text, {sys.fonts.tactical, viewport().width() / 2},
+                GetRGBTranslateColorShade(Hue::GREEN, LIGHTEST));
+    } else {
+        g.send_label->text().set_text(text);
+    }
     g.send_label->text().select(selection.begin, selection.end);
     g.send_label->text().mark(mark.begin, mark.end);
 
@@ -18,6 +18,7 @@
 
 #include "game/starfield.hpp"
 
+#include <stdlib.h>
 #include <sfz/sfz.hpp>
 
 #include "data/base-object.hpp"
@@ -234,6 +235,17 @@ void Starfield::move(ticks by_units) {
     }
 }
 
+// Where to draw `star` between ticks.  Stars which wrapped around the play screen during the
+// last tick are drawn where they are now, rather than streaking across it.
+static Point star_position(const scrollStarType& star) {
+    const Rect play_screen = antares::play_screen();
+    if ((abs(star.location.h - star.oldLocation.h) > (play_screen.width() / 2)) ||
+        (abs(star.location.v - star.oldLocation.v) > (play_screen.height() / 2))) {
+        return star.location;
+    }
+    return tick_position(star.oldLocation, star.location);
+}
+
 void Starfield::draw() const {
     const RgbColor slowColor   = GetRGBTranslateColorShade(kStarColor, MEDIUM);
     const RgbColor mediumColor = GetRGBTranslateColorShade(kStarColor, LIGHT);
@@ -253,7 +265,7 @@ void Starfield::draw() const {
                             color = &fastColor;
                         }
 
-                        points.draw(star->location, *color);
+                        points.draw(star_position(*star), *color);
                     }
                 }
                 break;
@@ -283,10 +295,14 @@ void Starfield::draw() const {
 
     Points points;
     for (const scrollStarType* star : range(_stars + kSparkStarOffset, _stars + kAllStarNum)) {
-        if ((star->speed != kNoStar) && (star->age > 0) && (viewport().contains(star->location))) {
+        if ((star->speed == kNoStar) || (star->age <= 0)) {
+            continue;
+        }
+        const Point at = star_position(*star);
+        if (viewport().contains(at)) {
             const RgbColor color =
                     GetRGBTranslateColorShade(star->hue, (star->age >> kSparkAgeToShadeShift) + 1);
-            points.draw(star->location, color);
+            points.draw(at, color);
         }
     }
 }
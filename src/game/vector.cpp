@@ -37,6 +37,7 @@
 using sfz::range;
 using std::abs;
 using std::max;
+using std::min;
 
 namespace antares {
 
@@ -93,8 +94,8 @@ Handle<Vector> Vectors::add(Point* location, const BaseObject::Ray& r) {
             vector->color                = RgbColor::clear();
             vector->hue                  = r.hue;
 
-            vector->thisBoltPoint[0] = vector->thisBoltPoint[kBoltPointNum - 1] =
-                    scale_to_viewport(*location);
+            std::fill_n(vector->thisBoltPoint, kBoltPointNum, scale_to_viewport(*location));
+            std::copy_n(vector->thisBoltPoint, kBoltPointNum, vector->lastBoltPoint);
 
             vector->is_ray          = true;
             vector->to_coord        = (r.to == BaseObject::Ray::To::COORD);
@@ -127,8 +128,8 @@ Handle<Vector> Vectors::add(Point* location, const BaseObject::Bolt& b) {
             vector->hue                  = sfz::nullopt;
             vector->color                = b.color;
 
-            vector->thisBoltPoint[0] = vector->thisBoltPoint[kBoltPointNum - 1] =
-                    scale_to_viewport(*location);
+            std::fill_n(vector->thisBoltPoint, kBoltPointNum, scale_to_viewport(*location));
+            std::copy_n(vector->thisBoltPoint, kBoltPointNum, vector->lastBoltPoint);
 
             vector->is_ray          = false;
             vector->to_coord        = false;
@@ -236,12 +237,34 @@ void Vectors::update() {
     }
 }
 
+// Returns the smallest Rect containing every point in `p` that a vector draws through.
+static Rect bounds(const Point (&p)[kBoltPointNum], bool lightning) {
+    Rect r(p[0].h, p[0].v, p[0].h + 1, p[0].v + 1);
+    for (int j : range(1, kBoltPointNum)) {
+        if (!lightning && (j != kBoltPointNum - 1)) {
+            continue;
+        }
+        r.left   = min(r.left, p[j].h);
+        r.top    = min(r.top, p[j].v);
+        r.right  = max(r.right, p[j].h + 1);
+        r.bottom = max(r.bottom, p[j].v + 1);
+    }
+    return r;
+}
+
 void Vectors::draw() {
-    Lines lines;
+    const Rect clip = viewport();
+    Lines      lines;
     for (auto vector : Vector::all()) {
         if (vector->active && !vector->killMe) {
             if (vector->visible) {
-                const auto& p = vector->thisBoltPoint;
+                Point p[kBoltPointNum];
+                for (int j : range(0, kBoltPointNum)) {
+                    p[j] = tick_position(vector->lastBoltPoint[j], vector->thisBoltPoint[j]);
+                }
+                if (!bounds(p, vector->lightning).intersects(clip)) {
+                    continue;
+                }
                 if (vector->lightning) {
                     for (int j : range(0, kBoltPointNum - 1)) {
                         lines.draw(p[j], p[j + 1], vector->color);
@@ -254,6 +277,12 @@ void Vectors::draw() {
     }
 }
 
+void Vectors::remember_positions() {
+    for (auto vector : Vector::all()) {
+        std::copy_n(vector->thisBoltPoint, kBoltPointNum, vector->lastBoltPoint);
+    }
+}
+
 void Vectors::cull() {
     for (auto vector : Vector::all()) {
         vector->active = vector->active && !vector->killMe;
@@ -21,6 +21,8 @@
 #include <GLFW/glfw3.h>
 #include <sys/time.h>
 #include <unistd.h>
+#include <algorithm>
+#include <chrono>
 
 #include <game/sys.hpp>
 #include <pn/output>
@@ -166,7 +168,8 @@ GLFWVideoDriver::GLFWVideoDriver()
         : _fullscreen(sys.prefs->fullscreen()),
           _screen_size(sys.prefs->window_size()),
           _last_click_count(0),
-          _text(nullptr) {
+          _text(nullptr),
+          _redraw(false) {
     if (!glfwInit()) {
         throw std::runtime_error("glfwInit()");
     }
@@ -410,34 +413,70 @@ void GLFWVideoDriver::window_maximize(bool maximized) {
 
 void GLFWVideoDriver::key_callback(GLFWwindow* w, int key, int scancode, int action, int mods) {
     GLFWVideoDriver* driver = reinterpret_cast<GLFWVideoDriver*>(glfwGetWindowUserPointer(w));
+    driver->_redraw         = true;
     driver->key(key, scancode, action, mods);
 }
 
 void GLFWVideoDriver::char_callback(GLFWwindow* w, unsigned int code_point) {
     GLFWVideoDriver* driver = reinterpret_cast<GLFWVideoDriver*>(glfwGetWindowUserPointer(w));
+    driver->_redraw         = true;
     driver->char_(code_point);
 }
 
 void GLFWVideoDriver::mouse_button_callback(GLFWwindow* w, int button, int action, int mods) {
     GLFWVideoDriver* driver = reinterpret_cast<GLFWVideoDriver*>(glfwGetWindowUserPointer(w));
+    driver->_redraw         = true;
     driver->mouse_button(button, action, mods);
 }
 
 void GLFWVideoDriver::mouse_move_callback(GLFWwindow* w, double x, double y) {
     GLFWVideoDriver* driver = reinterpret_cast<GLFWVideoDriver*>(glfwGetWindowUserPointer(w));
+    driver->_redraw         = true;
     driver->mouse_move(x, y);
 }
 
 void GLFWVideoDriver::window_size_callback(GLFWwindow* w, int width, int height) {
     GLFWVideoDriver* driver = reinterpret_cast<GLFWVideoDriver*>(glfwGetWindowUserPointer(w));
+    driver->_redraw         = true;
     driver->window_size(width, height);
 }
 
 void GLFWVideoDriver::window_maximize_callback(GLFWwindow* w, int maximized) {
     GLFWVideoDriver* driver = reinterpret_cast<GLFWVideoDriver*>(glfwGetWindowUserPointer(w));
+    driver->_redraw         = true;
     driver->window_maximize(maximized);
 }
 
+void GLFWVideoDriver::window_refresh_callback(GLFWwindow* w) {
+    GLFWVideoDriver* driver = reinterpret_cast<GLFWVideoDriver*>(glfwGetWindowUserPointer(w));
+    driver->_redraw         = true;
+}
+
+static void set_swap_interval(int interval) {
+    if ((interval < 0) && !glfwExtensionSupported("WGL_EXT_swap_control_tear") &&
+        !glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+        interval = 1;  // Adaptive vsync isn't available; fall back to plain vsync.
+    }
+    glfwSwapInterval(interval);
+}
+
+// Processes pending events, sleeping until one arrives or until `until`.
+void GLFWVideoDriver::wait_events(wall_time until) {
+    const wall_time t = now();
+    if (until <= t) {
+        glfwPollEvents();
+    } else if (until == wall_time::max()) {
+        glfwWaitEvents();
+    } else {
+#if GLFW_VERSION_MINOR >= 2
+        glfwWaitEventsTimeout(std::chrono::duration<double>(until - t).count());
+#else
+        glfwPollEvents();
+        usleep(std::min<int64_t>((until - t).count(), 1000));
+#endif
+    }
+}
+
 void GLFWVideoDriver::loop(Card* initial) {
     /* Create a windowed mode window and its OpenGL context */
     glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
@@ -471,28 +510,50 @@ void GLFWVideoDriver::loop(Card* initial) {
     glfwSetMouseButtonCallback(_window, mouse_button_callback);
     glfwSetCursorPosCallback(_window, mouse_move_callback);
     glfwSetWindowSizeCallback(_window, window_size_callback);
+    glfwSetWindowRefreshCallback(_window, window_refresh_callback);
 #if GLFW_VERSION_MINOR >= 3
     glfwSetWindowMaximizeCallback(_window, window_maximize_callback);
 #endif
 
     /* Make the _window's context current */
     glfwMakeContextCurrent(_window);
+    set_swap_interval(sys.prefs->swap_interval());
+
+    const int   frame_cap      = sys.prefs->frame_cap();
+    const usecs frame_interval = (frame_cap > 0) ? usecs(1000000 / frame_cap) : usecs(0);
 
     MainLoop main_loop(*this, initial);
-    _loop = &main_loop;
-    main_loop.draw();
+    _loop   = &main_loop;
+    _redraw = true;
+
+    wall_time next_frame = now();
 
     while (!main_loop.done() && !glfwWindowShouldClose(_window)) {
-        glfwPollEvents();
-        _loop->draw();
-        glfwSwapBuffers(_window);
+        // Sleep until there's input, the top card's timer is due, or a pending redraw can be
+        // drawn without exceeding the frame cap.  Nothing is drawn unless an event or timer
+        // might have changed what's on screen.
         wall_time at;
-        if (main_loop.top()->next_timer(at) && (now() > at)) {
+        wall_time wake = wall_time::max();
+        if (main_loop.top()->next_timer(at)) {
+            wake = at;
+        }
+        if (_redraw) {
+            wake = std::min(wake, next_frame);
+        }
+        wait_events(wake);
+        if (main_loop.done()) {
+            break;
+        }
+
+        if (main_loop.top()->next_timer(at) && (now() >= at)) {
             main_loop.top()->fire_timer();
+            _redraw = true;
+        }
+        if (_redraw && (now() >= next_frame)) {
             main_loop.draw();
             glfwSwapBuffers(_window);
-        } else {
-            usleep(10);
+            _redraw    = false;
+            next_frame = now() + frame_interval;
         }
     }
 }
@@ -35,14 +35,15 @@ namespace antares {
 
 namespace {
 
-static const char kKeySettingsPreference[]  = "KeySettings";
-static const char kIdleMusicPreference[]    = "PlayIdleMusic";
-static const char kGameMusicPreference[]    = "PlayGameMusic";
-static const char kSpeechOnPreference[]     = "SpeechOn";
-static const char kVolumePreference[]       = "Volume";
-static const char kFullscreenPreference[]   = "Fullscreen";
-static const char kWindowWidthPreference[]  = "WindowWidth";
-static const char kWindowHeightPreference[] = "WindowHeight";
+static const char kKeySettingsPreference[]   = "KeySettings";
+static const char kIdleMusicPreference[]     = "PlayIdleMusic";
+static const char kGameMusicPreference[]     = "PlayGameMusic";
+static const char kSpeechOnPreference[]      = "SpeechOn";
+static const char kVolumePreference[]        = "Volume";
+static const char kFullscreenPreference[]    = "Fullscreen";
+static const char kWindowWidthPreference[]   = "WindowWidth";
+static const char kWindowHeightPreference[]  = "WindowHeight";
+static const char kDiscardPixelsPreference[] = "DiscardPixels";
 
 template <typename T>
 T clamp(T value, T min, T max) {
@@ -107,6 +108,9 @@ CoreFoundationPrefsDriver::CoreFoundationPrefsDriver() {
         if (cf::get_preference(kFullscreenPreference, cfbool) && cf::unwrap(cfbool, val)) {
             _current.fullscreen = val;
         }
+        if (cf::get_preference(kDiscardPixelsPreference, cfbool) && cf::unwrap(cfbool, val)) {
+            _current.discard_pixels = val;
+        }
     }
 
     {
@@ -145,6 +149,7 @@ void CoreFoundationPrefsDriver::set(const Preferences& preferences) {
     cf::set_preference(kFullscreenPreference, cf::wrap(preferences.fullscreen));
     cf::set_preference(kWindowWidthPreference, cf::wrap(preferences.window_size.width));
     cf::set_preference(kWindowHeightPreference, cf::wrap(preferences.window_size.height));
+    cf::set_preference(kDiscardPixelsPreference, cf::wrap(preferences.discard_pixels));
     CFPreferencesAppSynchronize(kCFPreferencesCurrentApplication);
 }
 
@@ -184,7 +184,7 @@ void SoundFX::play(pn::string_view id, uint8_t amplitude, usecs persistence, uin
     }
 }
 
-SoundFX::SoundFX() {}
+SoundFX::SoundFX() : _cache(kSoundCacheBytes) {}
 SoundFX::~SoundFX() {}
 
 void SoundFX::init() {
@@ -201,6 +201,10 @@ void SoundFX::init() {
 }
 
 void SoundFX::reset() {
+    for (size_t i = kMinVolatileSound; i < sounds.size(); ++i) {
+        size_t bytes = sounds[i].soundHandle->bytes();
+        _cache.put(std::move(sounds[i].id), std::move(sounds[i].soundHandle), bytes);
+    }
     sounds.resize(kMinVolatileSound);
     for (int i = 0; i < kMinVolatileSound; ++i) {
         if (!sounds[i].soundHandle.get()) {
@@ -218,12 +222,16 @@ void SoundFX::load(pn::string_view id) {
     }
 
     if (whichSound == sounds.size()) {
+        sfz::optional<std::unique_ptr<Sound>> cached = _cache.take(id.copy());
         sounds.emplace_back();
         sounds.back().id          = id.copy();
-        sounds.back().soundHandle = sys.audio->open_sound(id);
+        sounds.back().soundHandle = cached.has_value() ? std::move(*cached)
+                                                       : sys.audio->open_sound(id);
     }
 }
 
+void SoundFX::flush() { _cache.clear(); }
+
 void SoundFX::stop() {
     for (int i = 0; i < kMaxChannelNum; i++) {
         channels[i].channelPtr->quiet();
@@ -60,13 +60,15 @@ class OpenAlSoundDriver::OpenAlSound : public Sound {
         alGetError();  // discard.
     }
 
-    virtual void play(uint8_t volume);
-    virtual void loop(uint8_t volume);
+    virtual void   play(uint8_t volume);
+    virtual void   loop(uint8_t volume);
+    virtual size_t bytes() const { return _bytes; }
 
     void buffer(const SoundData& s) {
         ALenum format = (s.channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
         alBufferData(_buffer, format, s.data.data(), s.data.size(), s.frequency);
         check_al_error("alBufferData");
+        _bytes = s.data.size();
     }
 
     ALuint buffer() const { return _buffer; }
@@ -81,6 +83,7 @@ class OpenAlSoundDriver::OpenAlSound : public Sound {
 
     const OpenAlSoundDriver& _driver;
     ALuint                   _buffer;
+    size_t                   _bytes = 0;
 };
 
 class OpenAlSoundDriver::OpenAlChannel : public SoundChannel {
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <pn/output>
 
+#include "game/sys.hpp"
 #include "video/driver.hpp"
 
 using std::unique_ptr;
@@ -49,6 +50,19 @@ CardStack* Card::stack() const { return _stack; }
 
 Card* Card::next() const { return _next.get(); }
 
+void Card::draw_next() const {
+    const Size size  = sys.video->screen_size();
+    const int  scale = sys.video->scale();
+    if (_next_image && (size == _next_image_size) && (scale == _next_image_scale)) {
+        _next_image.draw(size.as_rect());
+        return;
+    }
+    next()->draw();
+    _next_image       = sys.video->capture();
+    _next_image_size  = size;
+    _next_image_scale = scale;
+}
+
 CardStack::CardStack(Card* top) { push(top); }
 
 bool CardStack::empty() const { return _top == nullptr; }
@@ -75,6 +89,7 @@ void CardStack::pop(Card* card) {
     swap(_top, old);
     swap(_top, old->_next);
     if (!empty()) {
+        _top->_next_image = nullptr;
         _top->become_front();
     }
 }
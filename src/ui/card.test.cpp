@@ -0,0 +1,103 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "ui/card.hpp"
+
+#include <gmock/gmock.h>
+
+#include "video/software-driver.hpp"
+#include "video/text-driver.hpp"
+
+using ::testing::Eq;
+
+namespace antares {
+namespace {
+
+// Counts how many times it is drawn.
+class CountingCard : public Card {
+  public:
+    CountingCard(int* draws) : _draws(draws) {}
+
+    virtual void draw() const {
+        ++*_draws;
+        Rects().fill(Rect(10, 10, 20, 20), RgbColor::white());
+    }
+
+  private:
+    int* _draws;
+};
+
+// Covers the card below in part, as a modal screen does.
+class CoveringCard : public Card {
+  public:
+    virtual void draw() const {
+        draw_next();
+        Rects().fill(Rect(15, 15, 25, 25), RgbColor::black());
+    }
+};
+
+using CardTest = testing::Test;
+
+TEST_F(CardTest, DrawNextKeepsCopy) {
+    SoftwareVideoDriver video({640, 480}, sfz::nullopt);
+    int                 draws = 0;
+    CardStack           stack(new CountingCard(&draws));
+
+    stack.push(new CoveringCard);
+    stack.top()->draw();
+    EXPECT_THAT(draws, Eq(1));
+    stack.top()->draw();
+    stack.top()->draw();
+    EXPECT_THAT(draws, Eq(1));  // Later frames draw the copy.
+
+    // A card pushed over the covering card draws it, and through it, the copy.
+    stack.push(new CoveringCard);
+    stack.top()->draw();
+    EXPECT_THAT(draws, Eq(1));
+
+    // When the covering card becomes front-most again, its copy is dropped.
+    stack.pop(stack.top());
+    stack.top()->draw();
+    EXPECT_THAT(draws, Eq(2));
+    stack.top()->draw();
+    EXPECT_THAT(draws, Eq(2));
+
+    // A new covering card takes a copy of its own.
+    stack.pop(stack.top());
+    stack.push(new CoveringCard);
+    stack.top()->draw();
+    EXPECT_THAT(draws, Eq(3));
+    stack.top()->draw();
+    EXPECT_THAT(draws, Eq(3));
+}
+
+TEST_F(CardTest, DrawNextWithoutCapture) {
+    TextVideoDriver video({640, 480}, sfz::nullopt);
+    int             draws = 0;
+    CardStack       stack(new CountingCard(&draws));
+
+    // The text driver can't capture, so the card below is drawn every time.
+    stack.push(new CoveringCard);
+    stack.top()->draw();
+    stack.top()->draw();
+    stack.top()->draw();
+    EXPECT_THAT(draws, Eq(3));
+}
+
+}  // namespace
+}  // namespace antares
@@ -84,12 +84,46 @@ static void enlarge_to_outer_bounds(Rect* r, const Widgets& widgets) {
     }
 }
 
+template <typename Widgets>
+static void append_states(std::vector<uint64_t>* states, const Widgets& widgets) {
+    for (const auto& w : widgets) {
+        states->push_back(w->state());
+        append_states(states, w->children());
+    }
+}
+
+// Only draws the widgets when one of them has changed state, or the screen has changed.
+// Otherwise, the copy of the screen from the last time they were drawn is shown instead.
 void InterfaceScreen::draw() const {
+    std::vector<uint64_t> states;
+    append_states(&states, _widgets);
+    const Size      screen_size = sys.video->screen_size();
+    const int       scale       = sys.video->scale();
+    const InputMode mode        = sys.video->input_mode();
+    if (_image.texture && (_image.screen_size == screen_size) && (_image.scale == scale) &&
+        (_image.mode == mode) && (_image.states == states)) {
+        _image.texture.draw(screen_size.as_rect());
+    } else {
+        draw_widgets();
+        _image.texture     = sys.video->capture();
+        _image.screen_size = screen_size;
+        _image.scale       = scale;
+        _image.mode        = mode;
+        _image.states      = std::move(states);
+    }
+
+    overlay();
+    if (stack()->top() == this) {
+        _cursor.draw();
+    }
+}
+
+void InterfaceScreen::draw_widgets() const {
     Rect copy_area;
     if (_full_screen) {
         copy_area = _bounds;
     } else {
-        next()->draw();
+        draw_next();
         copy_area = _widgets[0]->outer_bounds();
         enlarge_to_outer_bounds(&copy_area, _widgets);
     }
@@ -101,10 +135,6 @@ void InterfaceScreen::draw() const {
     for (const auto& w : _widgets) {
         w->draw(off, sys.video->input_mode());
     }
-    overlay();
-    if (stack()->top() == this) {
-        _cursor.draw();
-    }
 }
 
 void InterfaceScreen::mouse_down(const MouseDownEvent& event) {
@@ -137,7 +137,7 @@ void DebriefingScreen::become_front() {
 void DebriefingScreen::resign_front() {}
 
 void DebriefingScreen::draw() const {
-    next()->draw();
+    draw_next();
     Rects().fill(_pix_bounds, RgbColor::black());
     if (!_score.empty()) {
         _score.draw(_score_bounds);
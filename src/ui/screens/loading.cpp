@@ -43,7 +43,8 @@ LoadingScreen::LoadingScreen(const Level& level, bool* cancelled)
           _name_text{StyledText::retro(
                   level.base.name, {sys.fonts.title, 640, 0, 2, 220}, kLoadingForeColor)},
           _next_update(now() + kTypingDelay),
-          _next_teletype(_next_update) {
+          _next_teletype(_next_update),
+          _load_state(start_construct_level(level)) {
     _name_text.hide();
 }
 
@@ -65,8 +66,10 @@ void LoadingScreen::fire_timer() {
         case TYPING:
             while (_next_update < now()) {
                 if (_name_text.done()) {
-                    _state      = LOADING;
-                    _load_state = start_construct_level(_level);
+                    // Always pass through LOADING, even if the level is already loaded: how far
+                    // the load got while typing depends on the decoding threads, so the screen
+                    // shouldn't.
+                    _state = LOADING;
                     return;
                 }
                 _next_update += kTypingDelay;
@@ -78,6 +81,14 @@ void LoadingScreen::fire_timer() {
                     _next_teletype += 3 * kTypingDelay;
                 }
             }
+
+            // Load while typing, as long as it doesn't hold up the next character.  Sprites
+            // are decoded in the background meanwhile, so the level is often loaded by the time
+            // its name is typed out.
+            while ((now() < _next_update) && !_load_state.done &&
+                   construct_level_ready(_load_state)) {
+                construct_level(&_load_state);
+            }
             break;
 
         case LOADING:
@@ -113,7 +124,9 @@ void LoadingScreen::overlay() const {
     bar.offset(off.h, off.v);
     Rects rects;
     rects.fill(bar, dark);
-    bar.right = bar.left + (bar.width() * _load_state.step / _load_state.max);
+    // While the name is typed, the level loads behind the scenes, without showing progress.
+    int32_t step = (_state == TYPING) ? 0 : _load_state.step;
+    bar.right    = bar.left + (bar.width() * step / _load_state.max);
     rects.fill(bar, light);
 }
 
@@ -114,7 +114,7 @@ void SelectLevelScreen::key_down(const KeyDownEvent& event) {
                 case Key::N_TIMES:
                     _state          = UNLOCKING;
                     _unlock_chapter = 0;
-                    _unlock_digits  = ndigits(plug.levels.size());
+                    _unlock_digits  = ndigits(plug.level_index.size());
                     sys.sound.cloak_on();
                     return;
                 default: break;
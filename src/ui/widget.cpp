@@ -221,6 +221,8 @@ void    Widget::action() {}
 void Widget::activate() {}
 void Widget::deactivate() {}
 
+uint64_t Widget::state() const { return 0; }
+
 std::vector<const Widget*> Widget::children() const { return std::vector<const Widget*>{}; }
 std::vector<Widget*>       Widget::children() { return std::vector<Widget*>{}; }
 
@@ -479,6 +481,12 @@ Widget* Button::accept_button(Gamepad::Button which) {
     return nullptr;
 }
 
+// Key and hue can be changed by the screen, for example to show a key binding or a selection.
+uint64_t Button::state() const {
+    return uint64_t(_active) | (uint64_t(enabled()) << 1) | (uint64_t(_hue) << 8) |
+           (uint64_t(_key) << 16);
+}
+
 PlainButton::PlainButton(const PlainButtonData& data) : Button{data}, _inner_bounds{data.bounds} {}
 
 void PlainButton::bind(Action a) { _action = a; }
@@ -682,6 +690,8 @@ bool CheckboxButton::enabled() const {
     }
 }
 
+uint64_t CheckboxButton::state() const { return Button::state() | (uint64_t(get()) << 2); }
+
 void CheckboxButton::action() { set(!get()); }
 
 void CheckboxButton::draw(Point offset, InputMode) const {
@@ -809,6 +819,8 @@ Rect CheckboxButton::outer_bounds() const {
 
 RadioButton::RadioButton(const RadioButtonData& data) : Button{data}, _inner_bounds{data.bounds} {}
 
+uint64_t RadioButton::state() const { return Button::state() | (uint64_t(_on) << 2); }
+
 void RadioButton::draw(Point offset, InputMode) const {
     /*
     Rect     tRect, uRect, vRect, wRect;
@@ -969,6 +981,8 @@ TabButton::TabButton(TabBox* box, const TabBoxData::Tab& data, Rect bounds)
     }
 }
 
+uint64_t TabButton::state() const { return Button::state() | (uint64_t(_on) << 2); }
+
 void TabButton::action() { parent()->select(*this); }
 
 void TabButton::draw(Point offset, InputMode) const {
@@ -1341,6 +1355,8 @@ Rect TabBox::outer_bounds() const {
     return bounds;
 }
 
+uint64_t TabBox::state() const { return _current_tab; }
+
 std::vector<const Widget*> TabBox::children() const { return children<const Widget>(); }
 std::vector<Widget*>       TabBox::children() { return children<Widget>(); }
 
@@ -0,0 +1,242 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "video/command-log.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace antares {
+
+const char kCommandLogMagic[4] = {'A', 'C', 'L', '1'};
+
+static const size_t kFlushSize = 64 * 1024;
+
+void CommandText::begin(pn::string_view command, pn::string& out) {
+    _out = &out;
+    _this.clear();
+    _this_ends.clear();
+    _this += command;
+    _this_ends.push_back(_this.size());
+
+    _new_command =
+            _last_ends.empty() || (pn::string_view{_last}.substr(0, _last_ends[0]) != command);
+    if (_new_command) {
+        *_out += command;
+    }
+}
+
+void CommandText::arg(int i) {
+    char s[16];
+    field(pn::string_view(s, snprintf(s, sizeof(s), "%d", i)));
+}
+
+void CommandText::arg(pn::string_view s) { field(s); }
+
+void CommandText::arg(const RgbColor& c) {
+    char s[9];
+    if (c.alpha != 255) {
+        snprintf(s, sizeof(s), "%02x%02x%02x%02x", c.red, c.green, c.blue, c.alpha);
+    } else {
+        snprintf(s, sizeof(s), "%02x%02x%02x", c.red, c.green, c.blue);
+    }
+    field(s);
+}
+
+void CommandText::field(pn::string_view s) {
+    const size_t i = _this_ends.size();
+    _this += s;
+    _this_ends.push_back(_this.size());
+
+    *_out += "\t";
+    if (_new_command || (i >= _last_ends.size()) ||
+        (pn::string_view{_last}.substr(_last_ends[i - 1], _last_ends[i] - _last_ends[i - 1]) !=
+         s)) {
+        *_out += s;
+    }
+}
+
+void CommandText::end() {
+    *_out += "\n";
+    _out = nullptr;
+
+    using std::swap;
+    swap(_this, _last);
+    swap(_this_ends, _last_ends);
+}
+
+CommandLogWriter::CommandLogWriter(pn::output out) : _out(std::move(out)) {
+    _buffer.reserve(kFlushSize);
+    _buffer.insert(_buffer.end(), kCommandLogMagic, kCommandLogMagic + sizeof(kCommandLogMagic));
+}
+
+CommandLogWriter::~CommandLogWriter() { flush(); }
+
+void CommandLogWriter::frame() { byte('F'); }
+
+void CommandLogWriter::command(pn::string_view name, int argc) {
+    if (_buffer.size() >= kFlushSize) {
+        flush();
+    }
+    byte('C');
+    string(name);
+    number(argc);
+}
+
+void CommandLogWriter::arg(int i) {
+    byte('i');
+    number((uint64_t(int64_t(i)) << 1) ^ uint64_t(int64_t(i) >> 63));
+}
+
+void CommandLogWriter::arg(pn::string_view s) {
+    byte('s');
+    string(s);
+}
+
+void CommandLogWriter::arg(const RgbColor& c) {
+    byte('c');
+    byte(c.red);
+    byte(c.green);
+    byte(c.blue);
+    byte(c.alpha);
+}
+
+void CommandLogWriter::snapshot(pn::string_view relpath) {
+    byte('S');
+    string(relpath);
+}
+
+void CommandLogWriter::number(uint64_t n) {
+    while (n >= 0x80) {
+        byte(0x80 | (n & 0x7f));
+        n >>= 7;
+    }
+    byte(n);
+}
+
+void CommandLogWriter::string(pn::string_view s) {
+    number(s.size());
+    _buffer.insert(_buffer.end(), s.data(), s.data() + s.size());
+}
+
+void CommandLogWriter::flush() {
+    if (!_buffer.empty()) {
+        _out.write(pn::data_view{_buffer.data(), static_cast<int>(_buffer.size())});
+        _buffer.clear();
+    }
+}
+
+namespace {
+
+class CommandLogReader {
+  public:
+    CommandLogReader(pn::data_view log) : _data(log.data()), _end(log.data() + log.size()) {}
+
+    bool done() const { return _data == _end; }
+
+    uint8_t byte() {
+        if (_data == _end) {
+            throw std::runtime_error("command log: unexpected end");
+        }
+        return *(_data++);
+    }
+
+    uint64_t number() {
+        uint64_t n = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = byte();
+            n |= uint64_t(b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                return n;
+            }
+        }
+        throw std::runtime_error("command log: bad number");
+    }
+
+    pn::string_view string() {
+        uint64_t size = number();
+        if (size > uint64_t(_end - _data)) {
+            throw std::runtime_error("command log: unexpected end");
+        }
+        pn::string_view s(reinterpret_cast<const char*>(_data), static_cast<int>(size));
+        _data += size;
+        return s;
+    }
+
+    void arg(CommandText& text) {
+        switch (byte()) {
+            case 'i': {
+                uint64_t n = number();
+                text.arg(int(int64_t(n >> 1) ^ -int64_t(n & 1)));
+                break;
+            }
+            case 's': text.arg(string()); break;
+            case 'c': {
+                uint8_t r = byte(), g = byte(), b = byte(), a = byte();
+                text.arg(rgba(r, g, b, a));
+                break;
+            }
+            default: throw std::runtime_error("command log: bad argument");
+        }
+    }
+
+  private:
+    const uint8_t* _data;
+    const uint8_t* _end;
+};
+
+}  // namespace
+
+void decode_command_log(
+        pn::data_view                                                log,
+        const std::function<void(pn::string_view, pn::string_view)>& snapshot) {
+    CommandLogReader in(log);
+    for (char c : kCommandLogMagic) {
+        if (in.done() || (in.byte() != uint8_t(c))) {
+            throw std::runtime_error("command log: bad header");
+        }
+    }
+
+    CommandText text;
+    pn::string  frame;
+    while (!in.done()) {
+        switch (in.byte()) {
+            case 'F':
+                text.reset();
+                frame.clear();
+                break;
+
+            case 'C': {
+                text.begin(in.string(), frame);
+                for (uint64_t n = in.number(); n > 0; --n) {
+                    in.arg(text);
+                }
+                text.end();
+                break;
+            }
+
+            case 'S': snapshot(in.string(), frame); break;
+
+            default: throw std::runtime_error("command log: bad record");
+        }
+    }
+}
+
+}  // namespace antares
@@ -0,0 +1,141 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "video/command-log.hpp"
+
+#include <gmock/gmock.h>
+#include <stdexcept>
+#include <vector>
+
+using testing::Eq;
+
+namespace antares {
+namespace {
+
+using CommandLogTest = testing::Test;
+
+std::vector<std::pair<pn::string, pn::string>> decode(pn::data_view log) {
+    std::vector<std::pair<pn::string, pn::string>> snapshots;
+    decode_command_log(log, [&snapshots](pn::string_view relpath, pn::string_view text) {
+        snapshots.emplace_back(relpath.copy(), text.copy());
+    });
+    return snapshots;
+}
+
+TEST_F(CommandLogTest, Text) {
+    CommandText text;
+    pn::string  out;
+
+    text.begin("rect", out);
+    text.arg(1);
+    text.arg(-2);
+    text.arg(rgb(255, 0, 0));
+    text.end();
+
+    text.begin("rect", out);  // Repeated fields are left blank.
+    text.arg(1);
+    text.arg(3);
+    text.arg(rgb(255, 0, 0));
+    text.end();
+
+    text.begin("draw", out);  // A new command repeats every field.
+    text.arg(1);
+    text.arg(3);
+    text.arg(rgba(0, 0, 255, 128));
+    text.arg("name");
+    text.end();
+
+    text.begin("draw", out);  // A field that the line above lacks is always written.
+    text.arg(1);
+    text.arg(3);
+    text.arg(rgba(0, 0, 255, 128));
+    text.arg("name");
+    text.arg(5);
+    text.end();
+
+    text.reset();
+    text.begin("draw", out);
+    text.arg(1);
+    text.end();
+
+    EXPECT_THAT(
+            out, Eq("rect\t1\t-2\tff0000\n"
+                    "\t\t3\t\n"
+                    "draw\t1\t3\t0000ff80\tname\n"
+                    "\t\t\t\t\t5\n"
+                    "draw\t1\n"));
+}
+
+TEST_F(CommandLogTest, RoundTrip) {
+    pn::data log;
+    {
+        CommandLogWriter writer(log.output());
+        writer.frame();
+        writer.command("rect", 3);
+        writer.arg(1);
+        writer.arg(-2);
+        writer.arg(rgb(255, 0, 0));
+        writer.command("rect", 3);
+        writer.arg(1);
+        writer.arg(3);
+        writer.arg(rgb(255, 0, 0));
+        writer.snapshot("screens/000001.txt");
+        writer.command("draw", 2);
+        writer.arg(-2147483647 - 1);
+        writer.arg("name");
+        writer.snapshot("screens/000002.txt");
+
+        writer.frame();
+        writer.command("rect", 1);
+        writer.arg(1);
+        writer.snapshot("screens/000003.txt");
+    }
+
+    auto snapshots = decode(log);
+    ASSERT_THAT(snapshots.size(), Eq(3u));
+    EXPECT_THAT(snapshots[0].first, Eq("screens/000001.txt"));
+    EXPECT_THAT(
+            snapshots[0].second, Eq("rect\t1\t-2\tff0000\n"
+                                    "\t\t3\t\n"));
+    EXPECT_THAT(snapshots[1].first, Eq("screens/000002.txt"));
+    EXPECT_THAT(
+            snapshots[1].second, Eq("rect\t1\t-2\tff0000\n"
+                                    "\t\t3\t\n"
+                                    "draw\t-2147483648\tname\n"));
+    EXPECT_THAT(snapshots[2].first, Eq("screens/000003.txt"));
+    EXPECT_THAT(snapshots[2].second, Eq("rect\t1\n"));
+}
+
+TEST_F(CommandLogTest, Malformed) {
+    pn::data log;
+    {
+        CommandLogWriter writer(log.output());
+        writer.frame();
+        writer.command("rect", 2);
+        writer.arg(1);
+        writer.arg(2);
+        writer.snapshot("screens/000001.txt");
+    }
+
+    EXPECT_THROW(decode(log.slice(0, 3)), std::runtime_error);                // header
+    EXPECT_THROW(decode(log.slice(0, log.size() - 1)), std::runtime_error);   // snapshot
+    EXPECT_THROW(decode(log.slice(0, log.size() - 22)), std::runtime_error);  // argument
+}
+
+}  // namespace
+}  // namespace antares
@@ -32,6 +32,8 @@ VideoDriver::VideoDriver() {
 
 VideoDriver::~VideoDriver() { sys.video = NULL; }
 
+Texture VideoDriver::capture() { return nullptr; }
+
 Texture::Impl::~Impl() {}
 
 TextReceiver::~TextReceiver() { sys.video->stop_editing(this); }
@@ -54,10 +56,26 @@ void Lines::draw(const Point& from, const Point& to, const RgbColor& color) cons
 
 Rects::Rects() { sys.video->begin_rects(); }
 
-Rects::~Rects() { sys.video->end_rects(); }
+Rects::Rects(std::vector<FilledRect>* recording) : _recording{recording} {}
+
+Rects::~Rects() {
+    if (!_recording) {
+        sys.video->end_rects();
+    }
+}
 
 void Rects::fill(const Rect& rect, const RgbColor& color) const {
-    sys.video->batch_rect(rect, color);
+    if (_recording) {
+        _recording->push_back(FilledRect{rect, color});
+    } else {
+        sys.video->batch_rect(rect, color);
+    }
+}
+
+void Rects::fill(const std::vector<FilledRect>& rects) const {
+    for (const FilledRect& r : rects) {
+        fill(r.rect, r.color);
+    }
 }
 
 Quads::Quads(const Texture& sprite) : _sprite(sprite) { _sprite._impl->begin_quads(); }
@@ -22,10 +22,16 @@
 #include <stdlib.h>
 #include <strings.h>
 #include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 #include <pn/output>
+#include <queue>
 #include <sfz/sfz.hpp>
+#include <thread>
 
 #include "config/preferences.hpp"
+#include "drawing/pix-kernels.hpp"
 #include "drawing/pix-map.hpp"
 #include "game/sys.hpp"
 #include "game/time.hpp"
@@ -59,30 +65,200 @@ namespace antares {
 
 namespace {
 
+// Encodes snapshots as PNG and writes them out on background threads, so that rendering can
+// continue in the meantime.
+class SnapshotWriter {
+  public:
+    SnapshotWriter() {
+        int threads = std::max<int>(1, std::min<int>(4, std::thread::hardware_concurrency() - 1));
+        for (int i = 0; i < threads; ++i) {
+            _threads.emplace_back([this] { run(); });
+        }
+        _max_jobs = 2 * threads;
+    }
+
+    // Drops any error, since destructors must not throw; call finish() to see it.
+    ~SnapshotWriter() { join(); }
+
+    // Waits for every queued snapshot to be written, and rethrows the first error that a write
+    // hit.  No more snapshots can be written afterwards.
+    void finish() {
+        join();
+        if (_error) {
+            std::rethrow_exception(_error);
+        }
+    }
+
+    // Queues `pix` to be written to `path`, waiting first if too many are already queued.
+    // Rethrows the first error that a previous write hit.
+    void write(ArrayPixMap pix, pn::string path) {
+        sfz::makedirs(path::dirname(path), 0755);
+        std::unique_lock<std::mutex> lock(_mutex);
+        _has_room.wait(lock, [this] { return _jobs.size() < _max_jobs; });
+        if (_error) {
+            std::rethrow_exception(_error);
+        }
+        _jobs.push(Job{std::move(pix), std::move(path)});
+        _has_job.notify_one();
+    }
+
+  private:
+    struct Job {
+        ArrayPixMap pix;
+        pn::string  path;
+    };
+
+    void join() {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done = true;
+        }
+        _has_job.notify_all();
+        for (auto& thread : _threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+    void run() {
+        while (true) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _has_job.wait(lock, [this] { return _done || !_jobs.empty(); });
+            if (_jobs.empty()) {
+                return;
+            }
+            Job job = std::move(_jobs.front());
+            _jobs.pop();
+            _has_room.notify_one();
+            lock.unlock();
+
+            try {
+                pn::output out{job.path, pn::binary};
+                job.pix.encode(out);
+            } catch (...) {
+                lock.lock();
+                if (!_error) {
+                    _error = std::current_exception();
+                }
+            }
+        }
+    }
+
+    std::mutex               _mutex;
+    std::condition_variable  _has_job;
+    std::condition_variable  _has_room;
+    std::queue<Job>          _jobs;
+    size_t                   _max_jobs;
+    bool                     _done = false;
+    std::exception_ptr       _error;
+    std::vector<std::thread> _threads;
+};
+
+// Reads snapshots back through a pair of pixel buffer objects.  glReadPixels() into a buffer
+// object returns without waiting for the transfer, so each snapshot is only mapped and
+// converted when the next one is started, or on finish().
 class SnapshotBuffer {
   public:
-    SnapshotBuffer() {}
+    SnapshotBuffer() { glGenBuffers(2, _pbo); }
+    ~SnapshotBuffer() { glDeleteBuffers(2, _pbo); }
+
+    void start(Rect bounds, pn::string path, SnapshotWriter& writer) {
+        start(bounds, Pending{PNG, bounds.size(), std::move(path), nullptr}, writer);
+    }
+
+    // Appends the snapshot to `video` as one raw BGRA frame, with rows from top to bottom.
+    void start(Rect bounds, pn::output* video, SnapshotWriter& writer) {
+        start(bounds, Pending{VIDEO, bounds.size(), pn::string{}, video}, writer);
+    }
+
+    // Appends a line to `hashes` with `name` and the snapshot's PixMap::digest(), which matches
+    // the digest of the pixels of the PNG that start() would have written.
+    void start_hash(Rect bounds, pn::string name, pn::output* hashes, SnapshotWriter& writer) {
+        start(bounds, Pending{HASH, bounds.size(), std::move(name), hashes}, writer);
+    }
 
-    void copy(Rect bounds, ArrayPixMap& pix) {
-        _data.resize(bounds.area() * 4);
+    void finish(SnapshotWriter& writer) {
+        finish(_next, writer);
+        finish(1 - _next, writer);
+    }
+
+  private:
+    enum Kind { PNG, VIDEO, HASH };
+
+    struct Pending {
+        Kind        kind;
+        Size        size;
+        pn::string  path;
+        pn::output* out;
+    };
+
+    void start(Rect bounds, Pending pending, SnapshotWriter& writer) {
         Size size = bounds.size();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo[_next]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bounds.area() * 4, nullptr, GL_STREAM_READ);
         glReadPixels(
                 bounds.left, bounds.top, size.width, size.height, GL_BGRA, GL_UNSIGNED_BYTE,
-                _data.data());
-        uint8_t* p = _data.data();
-        for (int32_t y : range(size.height)) {
-            for (int32_t x : range(size.width)) {
-                uint8_t blue  = *(p++);
-                uint8_t green = *(p++);
-                uint8_t red   = *(p++);
-                ++p;
-                pix.set(x, size.height - y - 1, rgb(red, green, blue));
+                nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        _pending[_next].emplace(std::move(pending));
+
+        _next = 1 - _next;
+        finish(_next, writer);
+    }
+
+    void finish(int i, SnapshotWriter& writer) {
+        if (!_pending[i].has_value()) {
+            return;
+        }
+        Pending pending = std::move(*_pending[i]);
+        _pending[i].reset();
+
+        ArrayPixMap pix((pending.kind == VIDEO) ? Size{0, 0} : pending.size);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo[i]);
+        auto data = static_cast<const uint8_t*>(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+        if (data) {
+            switch (pending.kind) {
+                case PNG: swizzle(data, pending.size, pix); break;
+                case VIDEO: write_frame(data, pending.size, *pending.out); break;
+                case HASH:
+                    swizzle(data, pending.size, pix);
+                    pending.out->format("{0}\t{1}\n", pending.path, pix.digest().hex());
+                    break;
             }
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if (!data) {
+            throw std::runtime_error("glMapBuffer");
+        }
+
+        if (pending.kind == PNG) {
+            writer.write(std::move(pix), std::move(pending.path));
         }
     }
 
-  private:
-    vector<uint8_t> _data;
+    // Writes bottom-up BGRA rows to `video` as they are, only reversing their order.  Frames
+    // are written on the calling thread, so they can't be reordered.
+    static void write_frame(const uint8_t* bgra, Size size, pn::output& video) {
+        const int row_bytes = size.width * 4;
+        for (int32_t y : range(size.height)) {
+            video.write(pn::data_view{bgra + (size.height - y - 1) * row_bytes, row_bytes});
+        }
+    }
+
+    // Converts bottom-up BGRA rows into a PixMap.
+    static void swizzle(const uint8_t* bgra, Size size, ArrayPixMap& pix) {
+        for (int32_t y : range(size.height)) {
+            bgra_row(
+                    pix.mutable_row(y), bgra + (size.height - y - 1) * size.width * 4,
+                    size.width);
+        }
+    }
+
+    GLuint                 _pbo[2];
+    int                    _next = 0;
+    sfz::optional<Pending> _pending[2];
 };
 
 void gl_check() {
@@ -128,27 +304,45 @@ class OffscreenVideoDriver::MainLoop : public EventScheduler::MainLoop {
         if (output_dir.has_value()) {
             _output_dir.emplace(output_dir->copy());
         }
+        if (driver._video_path.has_value()) {
+            _video.emplace(*driver._video_path, pn::binary);
+        }
+        if (_output_dir.has_value() && driver._hash_only) {
+            _hashes.emplace(pn::format("{0}/hashes.txt", *_output_dir), pn::text);
+        }
+    }
+
+    // Writes out the last snapshots, and throws if any snapshot couldn't be written.  Without a
+    // call to finish(), the last snapshots are dropped.
+    void finish() {
+        _buffer.finish(_writer);
+        _writer.finish();
     }
 
-    bool takes_snapshots() { return _output_dir.has_value(); }
+    bool takes_snapshots() { return _output_dir.has_value() || _video.has_value(); }
 
     void snapshot(wall_ticks ticks) {
+        if (_video.has_value()) {
+            Rect bounds = _driver._capture_rect;
+            bounds.offset(0, _driver._screen_size.height - bounds.height() - bounds.top);
+            _buffer.start(bounds, &*_video, _writer);
+            return;
+        }
         snapshot_to(
                 _driver._capture_rect,
                 pn::format("screens/{0}.png", dec(ticks.time_since_epoch().count(), 6)));
     }
 
     void snapshot_to(Rect bounds, pn::string_view relpath) {
-        if (!takes_snapshots()) {
+        if (!_output_dir.has_value()) {
             return;
         }
         bounds.offset(0, _driver._screen_size.height - bounds.height() - bounds.top);
-        ArrayPixMap pix(bounds.size());
-        _buffer.copy(bounds, pix);
-        pn::string path = pn::format("{0}/{1}", *_output_dir, relpath);
-        sfz::makedirs(path::dirname(path), 0755);
-        pn::output out{path, pn::binary};
-        pix.encode(out);
+        if (_hashes.has_value()) {
+            _buffer.start_hash(bounds, relpath.copy(), &*_hashes, _writer);
+            return;
+        }
+        _buffer.start(bounds, pn::format("{0}/{1}", *_output_dir, relpath), _writer);
     }
 
     void  draw() { _loop.draw(); }
@@ -160,6 +354,7 @@ class OffscreenVideoDriver::MainLoop : public EventScheduler::MainLoop {
     Offscreen                   _offscreen;
     Framebuffer                 _fb;
     Renderbuffer                _rb;
+    SnapshotWriter              _writer;
     SnapshotBuffer              _buffer;
     struct Setup {
         Setup(OffscreenVideoDriver::MainLoop& loop) {
@@ -174,6 +369,8 @@ class OffscreenVideoDriver::MainLoop : public EventScheduler::MainLoop {
     };
     Setup                       _setup;
     sfz::optional<pn::string>   _output_dir;
+    sfz::optional<pn::output>   _video;
+    sfz::optional<pn::output>   _hashes;
     OpenGlVideoDriver::MainLoop _loop;
 };
 
@@ -194,6 +391,7 @@ void OffscreenVideoDriver::loop(Card* initial, EventScheduler& scheduler) {
     MainLoop loop(*this, _output_dir, initial);
     _scheduler->loop(loop);
     _scheduler = nullptr;
+    loop.finish();
 }
 
 namespace {
@@ -221,6 +419,7 @@ void OffscreenVideoDriver::capture(vector<pair<unique_ptr<Card>, pn::string>>& p
         loop.snapshot_to(_capture_rect, p.second);
         loop.top()->stack()->pop(loop.top());
     }
+    loop.finish();
 }
 
 }  // namespace antares
@@ -21,6 +21,7 @@
 #include <stdint.h>
 #include <algorithm>
 #include <pn/output>
+#include <vector>
 
 #include "drawing/color.hpp"
 #include "drawing/pix-map.hpp"
@@ -122,6 +123,8 @@ static T _gl_check(T t, const char* fn, const char* file, int line) {
 #define glClear(mask) _GL(glClear, mask)
 #define glClearColor(red, green, blue, alpha) _GL(glClearColor, red, green, blue, alpha)
 #define glCompileShader(shader) _GL(glCompileShader, shader)
+#define glCopyTexImage2D(target, level, internalformat, x, y, width, height, border) \
+    _GL(glCopyTexImage2D, target, level, internalformat, x, y, width, height, border)
 #define glCreateProgram() _GLV(glCreateProgram)
 #define glCreateShader(shaderType) _GLV(glCreateShader, shaderType)
 #define glDeleteTextures(n, textures) _GL(glDeleteTextures, n, textures)
@@ -220,6 +223,23 @@ class OpenGlTextureImpl : public Texture::Impl {
                 copy.bytes());
     }
 
+    // A copy of the framebuffer, as captured by OpenGlVideoDriver::capture().  It is stored at
+    // the framebuffer's resolution and orientation, bottom row first, without a border.
+    // Drawing it replaces the pixels beneath it, rather than blending with them, so a captured
+    // frame composites back exactly.
+    OpenGlTextureImpl(
+            Size size, int scale, const OpenGlVideoDriver::Uniforms& uniforms, GLuint vbuf[3])
+            : _size(size), _scale(scale), _captured(true), _uniforms(uniforms), _vbuf(vbuf) {
+        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
+        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glCopyTexImage2D(
+                GL_TEXTURE_RECTANGLE, 0, GL_RGBA, 0, 0, size.width * scale, size.height * scale,
+                0);
+    }
+
     virtual pn::string_view name() const { return _name; }
 
     virtual void draw(const Rect& draw_rect) const {
@@ -258,7 +278,26 @@ class OpenGlTextureImpl : public Texture::Impl {
     virtual const Size& size() const { return _size; }
 
   private:
+    // Returns texture coordinates for `source`, which is in the texture's own units.
+    Rect texture_rect(const Rect& source) const {
+        Rect texture_rect = source;
+        texture_rect.scale(_scale, _scale);
+        if (_captured) {
+            // Rows run bottom to top, so the top of `source` is the greater coordinate.
+            const int32_t height = _size.height * _scale;
+            texture_rect = Rect(
+                    texture_rect.left, height - texture_rect.top, texture_rect.right,
+                    height - texture_rect.bottom);
+        } else {
+            texture_rect.offset(1, 1);
+        }
+        return texture_rect;
+    }
+
     virtual void draw_internal(const Rect& draw_rect, const RgbColor& tint) const {
+        if (_captured) {
+            glDisable(GL_BLEND);
+        }
         glEnableVertexAttribArray(0);
         glEnableVertexAttribArray(1);
         glEnableVertexAttribArray(2);
@@ -282,11 +321,13 @@ class OpenGlTextureImpl : public Texture::Impl {
         glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
 
         glBindBuffer(GL_ARRAY_BUFFER, _vbuf[2]);
-        const int32_t w            = _size.width / _scale;
-        const int32_t h            = _size.height / _scale;
-        GLshort       tex_coords[] = {
-                GLshort(1),     GLshort(1),     GLshort(1),     GLshort(h + 1),
-                GLshort(w + 1), GLshort(h + 1), GLshort(w + 1), GLshort(1),
+        const int32_t w   = _size.width / _scale;
+        const int32_t h   = _size.height / _scale;
+        const Rect    tex = _captured ? texture_rect(_size.as_rect()) : Rect(1, 1, w + 1, h + 1);
+
+        GLshort tex_coords[] = {
+                GLshort(tex.left),  GLshort(tex.top),    GLshort(tex.left),  GLshort(tex.bottom),
+                GLshort(tex.right), GLshort(tex.bottom), GLshort(tex.right), GLshort(tex.top),
         };
         glBufferData(GL_ARRAY_BUFFER, sizeof(tex_coords), tex_coords, GL_STREAM_DRAW);
         glVertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, 0, nullptr);
@@ -298,59 +339,90 @@ class OpenGlTextureImpl : public Texture::Impl {
         glDisableVertexAttribArray(2);
         glDisableVertexAttribArray(1);
         glDisableVertexAttribArray(0);
+        if (_captured) {
+            glEnable(GL_BLEND);
+        }
     }
 
+    // Quads are accumulated between begin_quads() and end_quads() and submitted as one batch of
+    // triangles, so that a run of glyphs costs a single draw call rather than one per glyph.
     virtual void begin_quads() const {
-        _uniforms.color_mode.set(TINT_SPRITE_MODE);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
+        if (_quads.depth++ == 0) {
+            _quads.vertices.clear();
+            _quads.colors.clear();
+            _quads.tex_coords.clear();
+        }
     }
 
-    virtual void end_quads() const {}
+    virtual void end_quads() const {
+        if ((--_quads.depth == 0) && !_quads.vertices.empty()) {
+            flush_quads();
+        }
+    }
 
     virtual void draw_quad(const Rect& dest, const Rect& source, const RgbColor& tint) const {
+        const Rect tex = texture_rect(source);
+
+        // Two triangles per quad: (top-left, bottom-left, bottom-right), (top-left,
+        // bottom-right, top-right).
+        const Point corners[] = {
+                {dest.left, dest.top},  {dest.left, dest.bottom},  {dest.right, dest.bottom},
+                {dest.left, dest.top},  {dest.right, dest.bottom}, {dest.right, dest.top},
+        };
+        const Point tex_coords[] = {
+                {tex.left, tex.top},  {tex.left, tex.bottom},  {tex.right, tex.bottom},
+                {tex.left, tex.top},  {tex.right, tex.bottom}, {tex.right, tex.top},
+        };
+        for (int i = 0; i < 6; ++i) {
+            _quads.vertices.push_back(corners[i].h);
+            _quads.vertices.push_back(corners[i].v);
+            _quads.colors.push_back(tint.red);
+            _quads.colors.push_back(tint.green);
+            _quads.colors.push_back(tint.blue);
+            _quads.colors.push_back(tint.alpha);
+            _quads.tex_coords.push_back(tex_coords[i].h);
+            _quads.tex_coords.push_back(tex_coords[i].v);
+        }
+    }
+
+    void flush_quads() const {
+        _uniforms.color_mode.set(TINT_SPRITE_MODE);
+
+        if (_captured) {
+            glDisable(GL_BLEND);
+        }
         glEnableVertexAttribArray(0);
         glEnableVertexAttribArray(1);
         glEnableVertexAttribArray(2);
 
         glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-        GLshort vertices[] = {
-                GLshort(dest.left),   GLshort(dest.top),   GLshort(dest.left),
-                GLshort(dest.bottom), GLshort(dest.right), GLshort(dest.bottom),
-                GLshort(dest.right),  GLshort(dest.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
+        glBufferData(
+                GL_ARRAY_BUFFER, _quads.vertices.size() * sizeof(GLshort),
+                _quads.vertices.data(), GL_STREAM_DRAW);
         glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, 0, nullptr);
 
         glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-        GLubyte colors[] = {
-                tint.red,  tint.green, tint.blue, tint.alpha, tint.red,  tint.green,
-                tint.blue, tint.alpha, tint.red,  tint.green, tint.blue, tint.alpha,
-                tint.red,  tint.green, tint.blue, tint.alpha,
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
+        glBufferData(
+                GL_ARRAY_BUFFER, _quads.colors.size() * sizeof(GLubyte), _quads.colors.data(),
+                GL_STREAM_DRAW);
         glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
 
-        Rect texture_rect = source;
-        texture_rect.scale(_scale, _scale);
-        texture_rect.offset(1, 1);
         glBindBuffer(GL_ARRAY_BUFFER, _vbuf[2]);
-        GLshort tex_coords[] = {
-                GLshort(texture_rect.left),  GLshort(texture_rect.top),
-                GLshort(texture_rect.left),  GLshort(texture_rect.bottom),
-                GLshort(texture_rect.right), GLshort(texture_rect.bottom),
-                GLshort(texture_rect.right), GLshort(texture_rect.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(tex_coords), tex_coords, GL_STREAM_DRAW);
+        glBufferData(
+                GL_ARRAY_BUFFER, _quads.tex_coords.size() * sizeof(GLshort),
+                _quads.tex_coords.data(), GL_STREAM_DRAW);
         glVertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, 0, nullptr);
 
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+        glDrawArrays(GL_TRIANGLES, 0, _quads.vertices.size() / 2);
 
         glDisableVertexAttribArray(2);
         glDisableVertexAttribArray(1);
         glDisableVertexAttribArray(0);
+        if (_captured) {
+            glEnable(GL_BLEND);
+        }
     }
 
     struct Texture {
@@ -362,12 +434,21 @@ class OpenGlTextureImpl : public Texture::Impl {
         GLuint id;
     };
 
+    struct QuadBatch {
+        int                  depth = 0;
+        std::vector<GLshort> vertices;
+        std::vector<GLubyte> colors;
+        std::vector<GLshort> tex_coords;
+    };
+
     const pn::string                   _name;
     Texture                            _texture;
     Size                               _size;
     int                                _scale;
+    const bool                         _captured = false;
     const OpenGlVideoDriver::Uniforms& _uniforms;
     GLuint*                            _vbuf;
+    mutable QuadBatch                  _quads;
 };
 
 }  // namespace
@@ -381,40 +462,77 @@ Texture OpenGlVideoDriver::texture(pn::string_view name, const PixMap& content,
             new OpenGlTextureImpl(name, content, scale, _uniforms, _vbuf));
 }
 
-void OpenGlVideoDriver::begin_rects() { _uniforms.color_mode.set(FILL_MODE); }
+Texture OpenGlVideoDriver::capture() {
+    return unique_ptr<Texture::Impl>(
+            new OpenGlTextureImpl(screen_size(), scale(), _uniforms, _vbuf));
+}
+
+// Rects are accumulated between begin_rects() and end_rects() and submitted as one batch of
+// triangles, so that a panel made of many small fills costs a single draw call.
+void OpenGlVideoDriver::begin_rects() {
+    if (_rects.depth++ == 0) {
+        _rects.vertices.clear();
+        _rects.colors.clear();
+    }
+}
 
 void OpenGlVideoDriver::batch_rect(const Rect& rect, const RgbColor& color) {
+    // Two triangles per rect: (top-right, top-left, bottom-left), (top-right, bottom-left,
+    // bottom-right).
+    const Point corners[] = {
+            {rect.right, rect.top},    {rect.left, rect.top},     {rect.left, rect.bottom},
+            {rect.right, rect.top},    {rect.left, rect.bottom},  {rect.right, rect.bottom},
+    };
+    for (const Point& p : corners) {
+        _rects.vertices.push_back(p.h);
+        _rects.vertices.push_back(p.v);
+        _rects.colors.push_back(color.red);
+        _rects.colors.push_back(color.green);
+        _rects.colors.push_back(color.blue);
+        _rects.colors.push_back(color.alpha);
+    }
+}
+
+void OpenGlVideoDriver::end_rects() {
+    if (--_rects.depth == 0) {
+        flush_rects(FILL_MODE);
+    }
+}
+
+void OpenGlVideoDriver::flush_rects(int color_mode) {
+    if (_rects.vertices.empty()) {
+        return;
+    }
+    _uniforms.color_mode.set(color_mode);
+
     glEnableVertexAttribArray(0);
     glEnableVertexAttribArray(1);
 
     glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-    GLshort vertices[] = {
-            GLshort(rect.right), GLshort(rect.top),    GLshort(rect.left),  GLshort(rect.top),
-            GLshort(rect.left),  GLshort(rect.bottom), GLshort(rect.right), GLshort(rect.bottom),
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
+    glBufferData(
+            GL_ARRAY_BUFFER, _rects.vertices.size() * sizeof(GLshort), _rects.vertices.data(),
+            GL_STREAM_DRAW);
     glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, 0, nullptr);
 
     glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-    GLubyte colors[] = {
-            color.red,  color.green, color.blue, color.alpha, color.red,  color.green,
-            color.blue, color.alpha, color.red,  color.green, color.blue, color.alpha,
-            color.red,  color.green, color.blue, color.alpha,
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
+    glBufferData(
+            GL_ARRAY_BUFFER, _rects.colors.size() * sizeof(GLubyte), _rects.colors.data(),
+            GL_STREAM_DRAW);
     glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
 
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    glDrawArrays(GL_TRIANGLES, 0, _rects.vertices.size() / 2);
 
     glDisableVertexAttribArray(1);
     glDisableVertexAttribArray(0);
-}
 
-void OpenGlVideoDriver::end_rects() {}
+    _rects.vertices.clear();
+    _rects.colors.clear();
+}
 
 void OpenGlVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
-    _uniforms.color_mode.set(DITHER_MODE);
+    flush_rects(FILL_MODE);  // Any pending fills go beneath the dithered rect.
     batch_rect(rect, color);
+    flush_rects(DITHER_MODE);
 }
 
 void OpenGlVideoDriver::begin_points() { _uniforms.color_mode.set(FILL_MODE); }
@@ -0,0 +1,447 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "video/software-driver.hpp"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+
+#include "drawing/shapes.hpp"
+#include "game/sys.hpp"
+#include "ui/card.hpp"
+
+using sfz::dec;
+using sfz::range;
+using std::max;
+using std::min;
+using std::pair;
+using std::unique_ptr;
+using std::vector;
+
+namespace path = sfz::path;
+
+namespace antares {
+
+namespace {
+
+const int kStaticSize = 256;
+
+// Rounds `x / 255` to the nearest integer, for `x` in [0, 255 * 255], without dividing.
+inline uint8_t div255(int32_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+inline uint8_t mul(uint8_t a, uint8_t b) { return div255(a * b); }
+
+inline RgbColor mul(const RgbColor& a, const RgbColor& b) {
+    return rgba(
+            mul(a.red, b.red), mul(a.green, b.green), mul(a.blue, b.blue),
+            mul(a.alpha, b.alpha));
+}
+
+// Equivalent to glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA).  The destination is always
+// opaque, so its alpha is left alone.
+inline void blend(RgbColor* dst, const RgbColor& src) {
+    const int32_t a = src.alpha;
+    if (a == 255) {
+        dst->red   = src.red;
+        dst->green = src.green;
+        dst->blue  = src.blue;
+    } else if (a != 0) {
+        dst->red   = div255(src.red * a + dst->red * (255 - a));
+        dst->green = div255(src.green * a + dst->green * (255 - a));
+        dst->blue  = div255(src.blue * a + dst->blue * (255 - a));
+    }
+}
+
+// Blends `src` over a run of `count` pixels.  The per-channel source terms are hoisted out of
+// the loop, which leaves a plain multiply-add over contiguous pixels for the compiler to
+// vectorize.
+void blend_span(RgbColor* dst, int32_t count, const RgbColor& src) {
+    const int32_t a = src.alpha;
+    if (a == 255) {
+        std::fill(dst, dst + count, rgb(src.red, src.green, src.blue));
+        return;
+    } else if (a == 0) {
+        return;
+    }
+    const int32_t r = src.red * a, g = src.green * a, b = src.blue * a, inv = 255 - a;
+    for (int32_t i = 0; i < count; ++i) {
+        dst[i].red   = div255(r + dst[i].red * inv);
+        dst[i].green = div255(g + dst[i].green * inv);
+        dst[i].blue  = div255(b + dst[i].blue * inv);
+    }
+}
+
+// Maps `x`, a pixel in [from.begin, from.end), to the texel its center falls in, in
+// [to.begin, to.end).  This is the nearest-neighbor sampling done by GL_NEAREST.  Works for
+// pixels outside of `from` too, extrapolating.
+inline int32_t sample(
+        int32_t x, int32_t from_begin, int32_t from_size, int32_t to_begin, int32_t to_size) {
+    int64_t num = (2 * int64_t(x - from_begin) + 1) * to_size;
+    int64_t den = 2 * int64_t(from_size);
+    int64_t q   = num / den;
+    if ((num % den) && ((num < 0) != (den < 0))) {
+        --q;
+    }
+    return to_begin + q;
+}
+
+}  // namespace
+
+class SoftwareVideoDriver::TextureImpl : public Texture::Impl {
+  public:
+    TextureImpl(pn::string_view name, SoftwareVideoDriver& driver, const PixMap& image, int scale)
+            : _name(name.copy()),
+              _driver(driver),
+              _size(image.size()),
+              _scale(scale),
+              _pix(image.size().width + 2, image.size().height + 2) {
+        // Add a 1-pixel clear border, like OpenGlTextureImpl does.  Besides making outlines
+        // work, it lets texel lookups clamp to the edge of the image without special cases.
+        _pix.fill(RgbColor::clear());
+        _pix.view(Rect(1, 1, _size.width + 1, _size.height + 1)).copy(image);
+    }
+
+    virtual pn::string_view name() const { return _name; }
+
+    virtual void draw(const Rect& draw_rect) const {
+        draw_internal(draw_rect, full_rect(), [](const RgbColor& texel, int32_t, int32_t) {
+            return texel;
+        });
+    }
+
+    virtual void draw_cropped(const Rect& dest, const Rect& source, const RgbColor& tint) const {
+        draw_quad(dest, source, tint);
+    }
+
+    virtual void draw_shaded(const Rect& draw_rect, const RgbColor& tint) const {
+        draw_internal(draw_rect, full_rect(), [&tint](const RgbColor& texel, int32_t, int32_t) {
+            return mul(tint, texel);
+        });
+    }
+
+    virtual void draw_static(const Rect& draw_rect, const RgbColor& color, uint8_t frac) const {
+        // The shader looks up noise at the screen position, offset by the per-frame seed: one
+        // 256th of the seed horizontally, and all of it vertically.
+        const uint8_t* noise  = _driver._static_image.get();
+        const int32_t  seed   = _driver._seed;
+        const int32_t  offset = (seed + 128) >> 8;
+        draw_internal(
+                draw_rect, full_rect(),
+                [noise, seed, offset, &color, frac](
+                        const RgbColor& texel, int32_t x, int32_t y) -> RgbColor {
+                    int32_t s = (x + offset) & (kStaticSize - 1);
+                    int32_t t = (y + seed) & (kStaticSize - 1);
+                    if (noise[t * kStaticSize + s] <= frac) {
+                        return rgba(
+                                color.red, color.green, color.blue, mul(color.alpha, texel.alpha));
+                    }
+                    return texel;
+                });
+    }
+
+    virtual void draw_outlined(
+            const Rect& draw_rect, const RgbColor& outline_color,
+            const RgbColor& fill_color) const {
+        const Rect source = full_rect();
+        draw_internal(
+                draw_rect, source,
+                [this, &draw_rect, &source, &outline_color, &fill_color](
+                        const RgbColor& texel, int32_t x, int32_t y) -> RgbColor {
+                    int32_t neighborhood = 0;
+                    for (int32_t dy : {-1, 0, 1}) {
+                        for (int32_t dx : {-1, 0, 1}) {
+                            if (dx || dy) {
+                                neighborhood += at(draw_rect, source, x + dx, y + dy).alpha;
+                            }
+                        }
+                    }
+                    if ((8 * texel.alpha) > neighborhood) {
+                        return outline_color;
+                    } else if (texel.alpha > 0) {
+                        return fill_color;
+                    }
+                    return RgbColor::clear();
+                });
+    }
+
+    virtual const Size& size() const { return _size; }
+
+  private:
+    virtual void draw_quad(const Rect& dest, const Rect& source, const RgbColor& tint) const {
+        Rect texture_rect = source;
+        texture_rect.scale(_scale, _scale);
+        texture_rect.offset(1, 1);
+        draw_internal(dest, texture_rect, [&tint](const RgbColor& texel, int32_t, int32_t) {
+            return mul(tint, texel);
+        });
+    }
+
+    // The texture coordinates that OpenGlTextureImpl::draw_internal() uses.
+    Rect full_rect() const {
+        return Rect(1, 1, _size.width / _scale + 1, _size.height / _scale + 1);
+    }
+
+    // The texel that screen pixel (x, y) samples, when `source` is drawn to `dest`.
+    const RgbColor& at(const Rect& dest, const Rect& source, int32_t x, int32_t y) const {
+        int32_t s = sample(x, dest.left, dest.width(), source.left, source.width());
+        int32_t t = sample(y, dest.top, dest.height(), source.top, source.height());
+        s         = min(max(s, 0), _pix.size().width - 1);
+        t         = min(max(t, 0), _pix.size().height - 1);
+        return _pix.get(s, t);
+    }
+
+    // Runs `shade(texel, x, y)` for each screen pixel (x, y) in `dest`, blending the results
+    // onto the screen.  Texel columns are computed once per draw rather than once per pixel.
+    template <typename Shader>
+    void draw_internal(const Rect& dest, const Rect& source, const Shader& shade) const {
+        if ((dest.width() <= 0) || (dest.height() <= 0)) {
+            return;
+        }
+        ArrayPixMap& screen = _driver._screen;
+        Rect         clip   = dest;
+        clip.clip_to(screen.size().as_rect());
+        if ((clip.width() <= 0) || (clip.height() <= 0)) {
+            return;
+        }
+
+        vector<int32_t> columns(clip.width());
+        for (int32_t x : range(clip.left, clip.right)) {
+            int32_t s = sample(x, dest.left, dest.width(), source.left, source.width());
+            columns[x - clip.left] = min(max(s, 0), _pix.size().width - 1);
+        }
+        for (int32_t y : range(clip.top, clip.bottom)) {
+            int32_t t = sample(y, dest.top, dest.height(), source.top, source.height());
+            t         = min(max(t, 0), _pix.size().height - 1);
+            const RgbColor* in  = _pix.row(t);
+            RgbColor*       out = screen.mutable_row(y) + clip.left;
+            for (int32_t i : range(clip.width())) {
+                blend(&out[i], shade(in[columns[i]], clip.left + i, y));
+            }
+        }
+    }
+
+    const pn::string     _name;
+    SoftwareVideoDriver& _driver;
+    Size                 _size;
+    int                  _scale;
+    ArrayPixMap          _pix;
+};
+
+class SoftwareVideoDriver::MainLoop : public EventScheduler::MainLoop {
+  public:
+    MainLoop(SoftwareVideoDriver& driver, Card* initial) : _driver(driver), _stack(initial) {}
+
+    bool takes_snapshots() { return _driver._output_dir.has_value(); }
+
+    void snapshot(wall_ticks ticks) {
+        snapshot_to(pn::format("screens/{0}.png", dec(ticks.time_since_epoch().count(), 6)));
+    }
+
+    void snapshot_to(pn::string_view relpath) {
+        if (!takes_snapshots()) {
+            return;
+        }
+        pn::string path = pn::format("{0}/{1}", *_driver._output_dir, relpath);
+        sfz::makedirs(path::dirname(path), 0755);
+        pn::output out{path, pn::binary};
+        _driver._screen.view(_driver._capture_rect).encode(out);
+    }
+
+    void draw() {
+        if (done()) {
+            return;
+        }
+        _driver._screen.fill(RgbColor::black());
+
+        int32_t seed = {_driver._static_seed.next(256)};
+        seed <<= 8;
+        seed += _driver._static_seed.next(256);
+        _driver._seed = seed;
+
+        _stack.top()->draw();
+    }
+    bool  done() const { return _stack.empty(); }
+    Card* top() const { return _stack.top(); }
+
+  private:
+    SoftwareVideoDriver& _driver;
+    CardStack            _stack;
+};
+
+SoftwareVideoDriver::SoftwareVideoDriver(
+        Size screen_size, const sfz::optional<pn::string>& output_dir)
+        : _screen(screen_size),
+          _capture_rect(screen_size.as_rect()),
+          _static_seed{0},
+          _static_image(new uint8_t[kStaticSize * kStaticSize]) {
+    if (output_dir.has_value()) {
+        _output_dir.emplace(output_dir->copy());
+    }
+    _screen.fill(RgbColor::black());
+
+    // The same noise that OpenGlVideoDriver uploads as its static texture.
+    Random static_index = {0};
+    for (int i = 0; i < (kStaticSize * kStaticSize); ++i) {
+        _static_image[i] = static_index.next(256);
+    }
+}
+
+bool SoftwareVideoDriver::start_editing(TextReceiver* text) { return false; }
+
+void SoftwareVideoDriver::stop_editing(TextReceiver* text) {}
+
+Texture SoftwareVideoDriver::texture(pn::string_view name, const PixMap& content, int scale) {
+    return unique_ptr<Texture::Impl>(new TextureImpl(name, *this, content, scale));
+}
+
+// The screen is always opaque, so drawing the copy replaces what's beneath it.
+Texture SoftwareVideoDriver::capture() { return texture("", _screen, 1); }
+
+void SoftwareVideoDriver::fill(Rect rect, const RgbColor& color) {
+    rect.clip_to(_screen.size().as_rect());
+    if ((rect.width() <= 0) || (rect.height() <= 0)) {
+        return;
+    }
+    for (int32_t y : range(rect.top, rect.bottom)) {
+        blend_span(_screen.mutable_row(y) + rect.left, rect.width(), color);
+    }
+}
+
+void SoftwareVideoDriver::plot(int32_t x, int32_t y, const RgbColor& color) {
+    if ((x < 0) || (y < 0) || (x >= _screen.size().width) || (y >= _screen.size().height)) {
+        return;
+    }
+    blend(&_screen.mutable_row(y)[x], color);
+}
+
+void SoftwareVideoDriver::batch_rect(const Rect& rect, const RgbColor& color) {
+    fill(rect, color);
+}
+
+void SoftwareVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
+    RgbColor half = color;
+    half.alpha /= 2;
+    fill(rect, half);
+}
+
+void SoftwareVideoDriver::draw_point(const Point& at, const RgbColor& color) {
+    plot(at.h, at.v, color);
+}
+
+// Includes both end points, as OpenGlVideoDriver::batch_line() does.
+void SoftwareVideoDriver::draw_line(const Point& from, const Point& to, const RgbColor& color) {
+    int32_t x = from.h, y = from.v;
+    int32_t dx = abs(to.h - from.h), sx = (from.h < to.h) ? 1 : -1;
+    int32_t dy = -abs(to.v - from.v), sy = (from.v < to.v) ? 1 : -1;
+    int32_t err = dx + dy;
+    while (true) {
+        plot(x, y, color);
+        if ((x == to.h) && (y == to.v)) {
+            break;
+        }
+        int32_t e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y += sy;
+        }
+    }
+}
+
+void SoftwareVideoDriver::draw_triangle(const Rect& rect, const RgbColor& color) {
+    size_t size = min(rect.width(), rect.height());
+    Rect   to(0, 0, size, size);
+    to.offset(rect.left, rect.top);
+    if (_triangles.find(size) == _triangles.end()) {
+        ArrayPixMap pix(size, size);
+        pix.fill(RgbColor::clear());
+        draw_triangle_up(&pix, RgbColor::white());
+        _triangles[size] = texture("", pix, 1);
+    }
+    _triangles[size].draw_shaded(to, color);
+}
+
+void SoftwareVideoDriver::draw_diamond(const Rect& rect, const RgbColor& color) {
+    size_t size = min(rect.width(), rect.height());
+    Rect   to(0, 0, size, size);
+    to.offset(rect.left, rect.top);
+    if (_diamonds.find(size) == _diamonds.end()) {
+        ArrayPixMap pix(size, size);
+        pix.fill(RgbColor::clear());
+        draw_compat_diamond(&pix, RgbColor::white());
+        _diamonds[size] = texture("", pix, 1);
+    }
+    _diamonds[size].draw_shaded(to, color);
+}
+
+void SoftwareVideoDriver::draw_plus(const Rect& rect, const RgbColor& color) {
+    size_t size = min(rect.width(), rect.height());
+    Rect   to(0, 0, size, size);
+    to.offset(rect.left, rect.top);
+    if (_pluses.find(size) == _pluses.end()) {
+        ArrayPixMap pix(size, size);
+        pix.fill(RgbColor::clear());
+        draw_compat_plus(&pix, RgbColor::white());
+        _pluses[size] = texture("", pix, 1);
+    }
+    _pluses[size].draw_shaded(to, color);
+}
+
+void SoftwareVideoDriver::loop(Card* initial, EventScheduler& scheduler) {
+    _scheduler = &scheduler;
+    MainLoop loop(*this, initial);
+    _scheduler->loop(loop);
+    _scheduler = nullptr;
+}
+
+namespace {
+
+class DummyCard : public Card {
+  public:
+    void become_front() {
+        if (!_inited) {
+            sys_init();
+            _inited = true;
+        }
+    }
+
+  private:
+    bool _inited = false;
+};
+
+}  // namespace
+
+void SoftwareVideoDriver::capture(vector<pair<unique_ptr<Card>, pn::string>>& pix) {
+    MainLoop loop(*this, new DummyCard);
+    for (auto& p : pix) {
+        loop.top()->stack()->push(p.first.release());
+        loop.draw();
+        loop.snapshot_to(p.second);
+        loop.top()->stack()->pop(loop.top());
+    }
+}
+
+}  // namespace antares
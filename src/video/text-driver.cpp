@@ -35,7 +35,6 @@
 #include "ui/event.hpp"
 
 using sfz::dec;
-using std::make_pair;
 using std::max;
 using std::min;
 using std::pair;
@@ -45,20 +44,6 @@ namespace path = sfz::path;
 
 namespace antares {
 
-namespace {
-
-pn::string hex(RgbColor color) {
-    char s[9];
-    if (color.alpha != 255) {
-        sprintf(s, "%02x%02x%02x%02x", color.red, color.green, color.blue, color.alpha);
-    } else {
-        sprintf(s, "%02x%02x%02x", color.red, color.green, color.blue);
-    }
-    return s;
-}
-
-}  // namespace
-
 class TextVideoDriver::TextureImpl : public Texture::Impl {
   public:
     TextureImpl(pn::string_view name, TextVideoDriver& driver, Size size)
@@ -81,11 +66,11 @@ class TextVideoDriver::TextureImpl : public Texture::Impl {
         if (source.size() == dest.size()) {
             _driver.log(
                     "crop", dest.left, dest.top, dest.right, dest.bottom, source.left, source.top,
-                    hex(tint), _name);
+                    tint, _name);
         } else {
             _driver.log(
                     "crop", dest.left, dest.top, dest.right, dest.bottom, source.left, source.top,
-                    source.right, source.bottom, hex(tint), _name);
+                    source.right, source.bottom, tint, _name);
         }
     }
 
@@ -95,7 +80,7 @@ class TextVideoDriver::TextureImpl : public Texture::Impl {
         }
         _driver.log(
                 "tint", draw_rect.left, draw_rect.top, draw_rect.right, draw_rect.bottom,
-                hex(tint), _name);
+                tint, _name);
     }
 
     virtual void draw_static(const Rect& draw_rect, const RgbColor& color, uint8_t frac) const {
@@ -104,7 +89,7 @@ class TextVideoDriver::TextureImpl : public Texture::Impl {
         }
         _driver.log(
                 "static", draw_rect.left, draw_rect.top, draw_rect.right, draw_rect.bottom,
-                hex(color), frac, _name);
+                color, frac, _name);
     }
 
     virtual void draw_outlined(
@@ -115,7 +100,7 @@ class TextVideoDriver::TextureImpl : public Texture::Impl {
         }
         _driver.log(
                 "outline", draw_rect.left, draw_rect.top, draw_rect.right, draw_rect.bottom,
-                hex(outline_color), hex(fill_color), _name.copy());
+                outline_color, fill_color, _name);
     }
 
     virtual const Size& size() const { return _size; }
@@ -132,9 +117,18 @@ class TextVideoDriver::MainLoop : public EventScheduler::MainLoop {
             : _driver(driver), _stack(initial) {
         if (output_dir.has_value()) {
             _output_dir.emplace(output_dir->copy());
+            if (_driver._binary_log) {
+                _driver._binary.emplace(
+                        pn::output{pn::format("{0}/commands.bin", *_output_dir), pn::binary});
+            } else if (_driver._hash_only) {
+                _hashes.emplace(pn::format("{0}/hashes.txt", *_output_dir), pn::text);
+            }
         }
+        _driver._hash.emplace();
     }
 
+    ~MainLoop() { _driver._binary.reset(); }
+
     bool takes_snapshots() { return _output_dir.has_value(); }
 
     void snapshot(wall_ticks ticks) {
@@ -142,6 +136,16 @@ class TextVideoDriver::MainLoop : public EventScheduler::MainLoop {
     }
 
     void snapshot_to(pn::string_view relpath) {
+        if (_driver._binary.has_value()) {
+            _driver._binary->snapshot(relpath);
+            return;
+        } else if (_hashes.has_value()) {
+            if (!_digest.has_value()) {
+                _digest.emplace(_driver._hash->compute().hex());
+            }
+            _hashes->format("{0}\t{1}\n", relpath, *_digest);
+            return;
+        }
         pn::string path = pn::format("{0}/{1}", *_output_dir, relpath);
         sfz::makedirs(path::dirname(path), 0755);
         pn::output out{path, pn::binary};
@@ -150,7 +154,12 @@ class TextVideoDriver::MainLoop : public EventScheduler::MainLoop {
 
     void draw() {
         _driver._log.clear();
-        _driver._last_args.clear();
+        _driver._text.reset();
+        _driver._hash.emplace();
+        _digest.reset();
+        if (_driver._binary.has_value()) {
+            _driver._binary->frame();
+        }
         _stack.top()->draw();
     }
     bool  done() const { return _stack.empty(); }
@@ -159,6 +168,8 @@ class TextVideoDriver::MainLoop : public EventScheduler::MainLoop {
   private:
     TextVideoDriver&          _driver;
     sfz::optional<pn::string> _output_dir;
+    sfz::optional<pn::output> _hashes;
+    sfz::optional<pn::string> _digest;  // of the last frame drawn, once computed.
     CardStack                 _stack;
 };
 
@@ -184,40 +195,40 @@ void TextVideoDriver::batch_rect(const Rect& rect, const RgbColor& color) {
     if (!world().intersects(rect)) {
         return;
     }
-    log("rect", rect.left, rect.top, rect.right, rect.bottom, hex(color));
+    log("rect", rect.left, rect.top, rect.right, rect.bottom, color);
 }
 
 void TextVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
-    log("dither", rect.left, rect.top, rect.right, rect.bottom, hex(color));
+    log("dither", rect.left, rect.top, rect.right, rect.bottom, color);
 }
 
 void TextVideoDriver::draw_point(const Point& at, const RgbColor& color) {
-    log("point", at.h, at.v, hex(color));
+    log("point", at.h, at.v, color);
 }
 
 void TextVideoDriver::draw_line(const Point& from, const Point& to, const RgbColor& color) {
-    log("line", from.h, from.v, to.h, to.v, hex(color));
+    log("line", from.h, from.v, to.h, to.v, color);
 }
 
 void TextVideoDriver::draw_triangle(const Rect& rect, const RgbColor& color) {
     if (!world().intersects(rect)) {
         return;
     }
-    log("triangle", rect.left, rect.top, rect.right, rect.bottom, hex(color));
+    log("triangle", rect.left, rect.top, rect.right, rect.bottom, color);
 }
 
 void TextVideoDriver::draw_diamond(const Rect& rect, const RgbColor& color) {
     if (!world().intersects(rect)) {
         return;
     }
-    log("diamond", rect.left, rect.top, rect.right, rect.bottom, hex(color));
+    log("diamond", rect.left, rect.top, rect.right, rect.bottom, color);
 }
 
 void TextVideoDriver::draw_plus(const Rect& rect, const RgbColor& color) {
     if (!world().intersects(rect)) {
         return;
     }
-    log("plus", rect.left, rect.top, rect.right, rect.bottom, hex(color));
+    log("plus", rect.left, rect.top, rect.right, rect.bottom, color);
 }
 
 void TextVideoDriver::loop(Card* initial, EventScheduler& scheduler) {
@@ -254,47 +265,27 @@ void TextVideoDriver::capture(vector<pair<unique_ptr<Card>, pn::string>>& pix) {
     }
 }
 
-void TextVideoDriver::add_arg(pn::string_view arg, std::vector<std::pair<size_t, size_t>>& args) {
-    size_t start = _log.size();
-    _log += arg;
-    args.push_back(make_pair(start, _log.size() - start));
-}
-
-void TextVideoDriver::dup_arg(size_t index, std::vector<std::pair<size_t, size_t>>& args) {
-    args.push_back(_last_args[index]);
-}
-
-pn::string_view TextVideoDriver::last_arg(size_t index) const {
-    return _log.substr(_last_args[index].first, _last_args[index].second);
-}
-
-static pn::string log_string(int i) { return pn::dump(i, pn::dump_short); }
-static pn::string log_string(pn::string_view s) { return s.copy(); }
-
 template <typename... Args>
 void TextVideoDriver::log(pn::string_view command, const Args&... args) {
-    vector<pair<size_t, size_t>> this_args;
-    pn::string                   str_args[]  = {log_string(args)...};
-    bool                         new_command = _last_args.empty() || (command != last_arg(0));
-
-    if (new_command) {
-        add_arg(command, this_args);
-    } else {
-        dup_arg(0, this_args);
-    }
-    for (size_t i = 0; i < sizeof...(args); ++i) {
-        _log += "\t";
-        pn::string_view s(str_args[i]);
-        if (new_command || (s != last_arg(i + 1))) {
-            add_arg(s, this_args);
-        } else {
-            dup_arg(i + 1, this_args);
-        }
+    if (_binary.has_value()) {
+        _binary->command(command, sizeof...(args));
+        int unpack[] = {0, (_binary->arg(args), 0)...};
+        static_cast<void>(unpack);
+        return;
     }
-    _log += "\n";
 
-    using std::swap;
-    swap(this_args, _last_args);
+    // In hash-only mode, each line is formatted into `_line`, which is reused, and hashed.
+    pn::string& out = _hash_only ? _line : _log;
+    if (_hash_only) {
+        _line.clear();
+    }
+    _text.begin(command, out);
+    int unpack[] = {0, (_text.arg(args), 0)...};
+    static_cast<void>(unpack);
+    _text.end();
+    if (_hash_only) {
+        _hash->write(_line);
+    }
 }
 
 }  // namespace antares